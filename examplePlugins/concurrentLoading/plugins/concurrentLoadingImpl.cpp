@@ -13,6 +13,7 @@
 #include "helloWorld.h"
 #include "goodbyeWorld.h"
 #include "pluginManager.h"
+#include "taskExecutor.h"
 
 Plugin* helloWorldPluginPtr = nullptr;
 Plugin* goodbyeWorldPluginPtr = nullptr;
@@ -21,6 +22,7 @@ Plugin* runnerPluginPtr = nullptr;
 Runner* runner = nullptr;
 
 PluginManager* pm;
+TaskExecutor* executor;
 size_t g_counter = 0;
 RunnerDesc desc;
 
@@ -62,6 +64,7 @@ void ConcurrentLoadingImpl::initialize(size_t identifier)
     std::cout << "ConcurrentLoadingImpl::initialize " << std::endl;
 
     pm = PluginManager::Instance(identifier);
+    executor = TaskExecutor::Instance(identifier);
 
     // ATTEMPTING TO COMMENT BACK IN THIS CODE WILL LEAD TO THE PLUGIN STALLING
     // THE ENTIRE APPLICATION!
@@ -105,23 +108,23 @@ void ConcurrentLoadingImpl::release()
 }
 
 // The plug - in attempts to simultaneously load the helloWorld,
-// goodbyeWorld, and runner plugins via multi-threading. Mutex locking in the containerImpl and pluginManager functions
+// goodbyeWorld, and runner plugins via multi-threading (as three tasks on the shared task executor). Mutex locking in the containerImpl and pluginManager functions
 // effetively prevent this from happening and force each plug-in to be loaded one at a time, so as to preserve the integrity
 // of the shared data containers. Note here that the 2nd overloaded PluginManager::Load method comes in handy here, since it
-// allows us to pass plug-in pointers by reference inside each thread's ::Load method, thereby initializing those variables
-// and allowing us to later use them in our single-threaded environment after the 3 threads have been joined back up.
+// allows us to pass plug-in pointers by reference inside each task's ::Load method, thereby initializing those variables
+// and allowing us to later use them in our single-threaded environment after the 3 tasks have completed.
 // The plugin also directly pushes a function to runner for updating, mostly to show that Runner was really, truly successfully
-// loaded via thread3.
+// loaded via task3.
 void ConcurrentLoadingImpl::start()
 {
     std::cout << "ConcurrentLoadingImpl::start" << std::endl;
 
-    std::thread thread1([]() { pm->Load("helloWorld", helloWorldPluginPtr); });
-    std::thread thread2([]() { pm->Load("goodbyeWorld", goodbyeWorldPluginPtr); });
-    std::thread thread3([]() { pm->Load("runner", runnerPluginPtr); });
-    thread1.join();
-    thread2.join();
-    thread3.join();
+    std::future<void> task1 = executor->async([]() { pm->Load("helloWorld", helloWorldPluginPtr); });
+    std::future<void> task2 = executor->async([]() { pm->Load("goodbyeWorld", goodbyeWorldPluginPtr); });
+    std::future<void> task3 = executor->async([]() { pm->Load("runner", runnerPluginPtr); });
+    task1.wait();
+    task2.wait();
+    task3.wait();
 
     runner = (Runner*)runnerPluginPtr;
 
@@ -134,20 +137,20 @@ void ConcurrentLoadingImpl::start()
 }
 
 // Stops the Runner update loop before attempting to unload helloWorld, goodbyeWorld, and runner simultaneously
-// in three separate threads. Similar to Load(), the Unload() method is mutex-locked, so each plugin will be unloaded
-// one at a time (blocking the other threads until its native process finishes).
+// in three separate executor tasks. Similar to Load(), the Unload() method is mutex-locked, so each plugin will be unloaded
+// one at a time (blocking the other tasks until its native process finishes).
 void ConcurrentLoadingImpl::stop()
 {
     std::cout << "ConcurrentLoadingImpl::stop" << std::endl;
     std::this_thread::sleep_for(std::chrono::seconds(5));
     runner->stop();
-    std::thread thread4([]() { pm->Unload("helloWorld"); });
-    std::thread thread5([]() { pm->Unload("goodbyeWorld"); });
-    std::thread thread6([]() { pm->Unload("runner"); });
+    std::future<void> task4 = executor->async([]() { pm->Unload("helloWorld"); });
+    std::future<void> task5 = executor->async([]() { pm->Unload("goodbyeWorld"); });
+    std::future<void> task6 = executor->async([]() { pm->Unload("runner"); });
 
-    thread4.join();
-    thread5.join();
-    thread6.join();
+    task4.wait();
+    task5.wait();
+    task6.wait();
 }
 
 // Simple preupdate function.
@@ -40,9 +40,10 @@
 #endif
 
 #include "inputImpl.h"
+#include "taskExecutor.h"
 
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) \
-|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) \
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I) \
+|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I) \
 || defined(EVENT_RUNNER_I)
 #include "event.h"
 #endif
@@ -51,12 +52,23 @@
 #include "runner.h"
 #endif
 
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) \
-|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) \
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I) \
+|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I) \
 || defined(EVENT_RUNNER_I)
 EventStream<double>* es;
 std::vector<size_t> g_ids;
 #endif
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I)
+constexpr EventKey keyboardKey("input_keyboard");
+EventStream<double>::EventRef keyboardEvent;
+#endif
+#if defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I)
+constexpr EventKey mouseKey("input_mouse");
+EventStream<double>::EventRef mouseEvent;
+#endif
+#ifdef EVENT_RUNNER_I
+constexpr EventKey runnerKey("runner");
+#endif
 
 #ifdef DIRECT_RUNNER_I
 PluginManager* pm;
@@ -68,15 +80,45 @@ RunnerDesc rDesc;
 std::vector<InputDesc> Input::inputDescriptors;
 #endif
 
+TaskExecutor* executor;
 bool breakLoop = false;
 bool g_block = false;
 bool isAsync;
-std::vector<std::thread> kbt, mt;
+std::vector<std::future<void>> kbt, mt;
+#ifdef EVENT_DISPATCH_KEYBOARD_I
+Completion kbPending; // Becomes ready once every input_keyboard dispatch so far has been handled.
+#endif
+#ifdef EVENT_DISPATCH_MOUSE_I
+Completion mPending; // Becomes ready once every input_mouse dispatch so far has been handled.
+#endif
+#if defined(EVENT_DISPATCH_KEYBOARD_I) || defined(EVENT_DISPATCH_MOUSE_I)
+// Deadline of each dispatched input event. A handler still running past it is reported and detached, so that stop() (which
+// waits on the pending dispatches) can't hang on a handler that is itself calling stop().
+constexpr std::chrono::milliseconds InputHandlerBudget(500);
+#endif
 
 #if defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_MULTI_MOUSE_I)
-void callAsyncWrapper(std::string name)
+// Most executor tasks a multi-threaded input event may have in flight. Past that, the input loop waits for the oldest one to
+// finish before starting another, rather than piling up tasks (and futures) for every input without bound.
+constexpr size_t MaxInputTasks = 16;
+
+void callAsyncWrapper(const EventStream<double>::EventRef& event)
+{
+    es->callAsync(event, 0);
+}
+
+// Start an executor task that calls the event, after forgetting the tasks that have finished and, if there are still too many
+// in flight, waiting for the oldest one.
+void pushInputTask(std::vector<std::future<void>>& tasks, const EventStream<double>::EventRef& event)
 {
-    es->callAsync(name, 0);
+    tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+        [](const std::future<void>& task) { return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }), tasks.end());
+    if (tasks.size() >= MaxInputTasks)
+    {
+        tasks.front().wait();
+        tasks.erase(tasks.begin());
+    }
+    tasks.push_back(executor->async([&event]() { callAsyncWrapper(event); }));
 }
 #endif
 
@@ -285,11 +327,15 @@ void internalIteration(double dt)
                 KeyEventProc(irInBuf[i].Event.KeyEvent, inputData);
 
 #ifdef EVENT_SYNC_KEYBOARD_I
-                es->call("input_keyboard", 0);
+                es->call(keyboardEvent, 0);
 #elif defined(EVENT_ASYNC_KEYBOARD_I)
-                es->callAsync("input_keyboard", 0);
+                es->callAsync(keyboardEvent, 0);
 #elif defined(EVENT_MULTI_KEYBOARD_I)
-                kbt.push_back(std::thread(callAsyncWrapper, "input_keyboard"));
+                pushInputTask(kbt, keyboardEvent);
+#elif defined(EVENT_POST_KEYBOARD_I)
+                es->post(keyboardEvent, 0);
+#elif defined(EVENT_DISPATCH_KEYBOARD_I)
+                kbPending = Completion::whenAll({ kbPending, es->dispatch(keyboardEvent, 0) });
 #endif
 
 #ifdef DIRECT_KEYBOARD_I
@@ -312,11 +358,15 @@ void internalIteration(double dt)
                 MouseEventProc(irInBuf[i].Event.MouseEvent, inputData);
 
 #ifdef EVENT_SYNC_MOUSE_I
-                es->call("input_mouse", 0);
+                es->call(mouseEvent, 0);
 #elif defined(EVENT_ASYNC_MOUSE_I)
-                es->callAsync("input_mouse", 0);
+                es->callAsync(mouseEvent, 0);
 #elif defined(EVENT_MULTI_MOUSE_I)
-                mt.push_back(std::thread(callAsyncWrapper, "input_mouse"));
+                pushInputTask(mt, mouseEvent);
+#elif defined(EVENT_POST_MOUSE_I)
+                es->post(mouseEvent, 0);
+#elif defined(EVENT_DISPATCH_MOUSE_I)
+                mPending = Completion::whenAll({ mPending, es->dispatch(mouseEvent, 0) });
 
 #endif
 
@@ -382,11 +432,15 @@ void internalIteration(double dt)
             strcpy(inputData.key, keyString.c_str());
 
 #ifdef EVENT_SYNC_KEYBOARD_I
-            es->call("input_keyboard", 0);
+            es->call(keyboardEvent, 0);
 #elif defined(EVENT_ASYNC_KEYBOARD_I)
-            es->callAsync("input_keyboard", 0);
+            es->callAsync(keyboardEvent, 0);
 #elif defined(EVENT_MULTI_KEYBOARD_I)
-            kbt.push_back(std::thread(callAsyncWrapper, "input_keyboard"));
+            pushInputTask(kbt, keyboardEvent);
+#elif defined(EVENT_POST_KEYBOARD_I)
+            es->post(keyboardEvent, 0);
+#elif defined(EVENT_DISPATCH_KEYBOARD_I)
+            kbPending = Completion::whenAll({ kbPending, es->dispatch(keyboardEvent, 0) });
 #endif
 
 #ifdef DIRECT_KEYBOARD_I
@@ -447,11 +501,15 @@ void internalIteration(double dt)
         }
 
 #ifdef EVENT_SYNC_MOUSE_I
-        es->call("input_mouse", 0);
+        es->call(mouseEvent, 0);
 #elif defined(EVENT_ASYNC_MOUSE_I)
-        es->callAsync("input_mouse", 0);
+        es->callAsync(mouseEvent, 0);
 #elif defined(EVENT_MULTI_MOUSE_I)
-        kbt.push_back(std::thread(callAsyncWrapper, "input_mouse"));
+        pushInputTask(mt, mouseEvent);
+#elif defined(EVENT_POST_MOUSE_I)
+        es->post(mouseEvent, 0);
+#elif defined(EVENT_DISPATCH_MOUSE_I)
+        mPending = Completion::whenAll({ mPending, es->dispatch(mouseEvent, 0) });
 #endif
 
 #ifdef DIRECT_MOUSE_I
@@ -516,17 +574,30 @@ void InputImpl::initialize(size_t identifier)
     std::string configPath = std::string(exeDir) + "../plugins/input/start_option.cfg";
 #endif
     parseStartConfigFile(configPath);
+    executor = TaskExecutor::Instance(identifier);
 
-    // Create any necessary events and/or get a PluginManager instance.
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) \
-|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) \
+    // Create any necessary events (resolving them once, so that the input loop publishes without name lookups) and/or get a
+    // PluginManager instance.
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I) \
+|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I) \
 || defined(EVENT_RUNNER_I)
     es = EventStream<double>::Instance(identifier);
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I)
-    es->create("input_keyboard");
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I)
+    es->create(keyboardKey);
+    keyboardEvent = es->resolve(keyboardKey);
+#ifdef EVENT_DISPATCH_KEYBOARD_I
+    es->setDeadline(keyboardEvent, InputHandlerBudget, OverrunPolicy::Detach);
+#endif
+#endif
+#if defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I)
+    es->create(mouseKey);
+    mouseEvent = es->resolve(mouseKey);
+#if defined(EVENT_POST_MOUSE_I) && defined(CONFLATE_MOUSE_I)
+    es->setConflation(mouseEvent, true);
+#endif
+#ifdef EVENT_DISPATCH_MOUSE_I
+    es->setDeadline(mouseEvent, InputHandlerBudget, OverrunPolicy::Detach);
 #endif
-#if defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I)
-    es->create("input_mouse");
 #endif
 #endif
 #ifdef DIRECT_RUNNER_I
@@ -534,37 +605,46 @@ void InputImpl::initialize(size_t identifier)
 #endif
 }
 
-// Define what processes the plug-in runs immediately before it is unloaded the plugin manager. Join all separate threads made for
-// keyboard and mouse inputs if EVENT_MULTI_KEYBOARD_I and/or EVENT_MULTI_MOUSE_I are defined, destroy all input_keyboard and
+// Define what processes the plug-in runs immediately before it is unloaded the plugin manager. Wait for all executor tasks made for
+// keyboard and mouse inputs if EVENT_MULTI_KEYBOARD_I and/or EVENT_MULTI_MOUSE_I are defined (or for the dispatched events to be
+// handled, with EVENT_DISPATCH_KEYBOARD_I and/or EVENT_DISPATCH_MOUSE_I), destroy all input_keyboard and
 // input_mouse events, clear all descriptors, and unload Runner if it was loaded at start-time.
 void InputImpl::release()
 {
     std::cout << "InputImpl::release" << std::endl;
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I)
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I)
     std::cout << "CASE EVENT_KEYBOARD_I" << std::endl;
 #ifdef EVENT_MULTI_KEYBOARD_I
     for (int i = 0; i < kbt.size(); ++i)
     {
-        if (kbt[i].joinable())
+        if (kbt[i].valid())
         {
-            kbt[i].join();
+            kbt[i].wait();
         }
     }
 #endif
-    es->destroy("input_keyboard");
+#ifdef EVENT_DISPATCH_KEYBOARD_I
+    kbPending.wait();
+#endif
+    keyboardEvent = EventStream<double>::EventRef();
+    es->destroy(keyboardKey);
 #endif
-#if defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I)
+#if defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I)
     std::cout << "CASE EVENT_MOUSE_I" << std::endl;
 #ifdef EVENT_MULTI_MOUSE_I
     for (int i = 0; i < mt.size(); ++i)
     {
-        if (mt[i].joinable())
+        if (mt[i].valid())
         {
-            mt[i].join();
+            mt[i].wait();
         }
     }
 #endif
-    es->destroy("input_mouse");
+#ifdef EVENT_DISPATCH_MOUSE_I
+    mPending.wait();
+#endif
+    mouseEvent = EventStream<double>::EventRef();
+    es->destroy(mouseKey);
 #endif
 #if defined(DIRECT_KEYBOARD_I) || defined(DIRECT_MOUSE_I)
     std::cout << "CASE DIRECT_I" << std::endl;
@@ -579,8 +659,8 @@ void InputImpl::release()
 #endif
     }
 
-#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) \
-|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) \
+#if defined(EVENT_SYNC_KEYBOARD_I) || defined(EVENT_ASYNC_KEYBOARD_I) || defined(EVENT_MULTI_KEYBOARD_I) || defined(EVENT_POST_KEYBOARD_I) || defined(EVENT_DISPATCH_KEYBOARD_I) \
+|| defined(EVENT_SYNC_MOUSE_I) || defined(EVENT_ASYNC_MOUSE_I) || defined(EVENT_MULTI_MOUSE_I) || defined(EVENT_POST_MOUSE_I) || defined(EVENT_DISPATCH_MOUSE_I) \
 || defined(EVENT_RUNNER_I)
     es->requestDelete();
     es = nullptr;
@@ -590,14 +670,14 @@ void InputImpl::release()
 #endif
 }
 
-// Start the input plugin, possibly in a separate thread if specified to run asynchronously by the config file.
+// Start the input plugin, possibly on an executor-managed thread if specified to run asynchronously by the config file.
 void InputImpl::start()
 {
     std::cout << "InputImpl::start" << std::endl;
 
     if (isAsync)
     {
-        thread = std::thread(&InputImpl::start2, InputImpl());
+        loop = executor->asyncLongRunning([]() { InputImpl().start2(); });
     }
     else
     {
@@ -606,7 +686,7 @@ void InputImpl::start()
 }
 
 // Sets a parameter to break the update loop if asynchronous, or to pop off/unsubscribe from runner update loop if synchronous.
-// Also join any keyboard and/or mouse event threads if they exist.
+// Also wait for any keyboard and/or mouse event tasks if they exist.
 void InputImpl::stop()
 {
     std::cout << "InputImpl::stop" << std::endl;
@@ -614,29 +694,35 @@ void InputImpl::stop()
 #ifdef EVENT_MULTI_KEYBOARD_I
     for (int i = 0; i < kbt.size(); ++i)
     {
-        kbt[i].join();
+        kbt[i].wait();
     }
 #endif
+#ifdef EVENT_DISPATCH_KEYBOARD_I
+    kbPending.wait();
+#endif
 #ifdef EVENT_MULTI_MOUSE_I
     for (int i = 0; i < mt.size(); ++i)
     {
-        mt[i].join();
+        mt[i].wait();
     }
 #endif
+#ifdef EVENT_DISPATCH_MOUSE_I
+    mPending.wait();
+#endif
 
     if (isAsync)
     {
         breakLoop = true;
-        if (thread.joinable())
+        if (loop.valid())
         {
-            thread.join();
+            loop.wait();
         }
     }
 
     else
     {
 #ifdef EVENT_RUNNER_I
-        es->unsubscribe("runner", g_ids);
+        es->unsubscribe(runnerKey, g_ids);
 #endif
 #ifdef DIRECT_RUNNER_I
         runner->pop(rDesc);
@@ -681,12 +767,13 @@ void InputImpl::start2()
     {
 
 #ifdef EVENT_RUNNER_I
+        // Poll for input ahead of the runner event's other (default-priority) handlers, so that they see this tick's input.
 #ifdef _WIN32
-        g_ids = es->subscribe("runner", &(::internalIteration));
+        g_ids = es->subscribe(runnerKey, &(::internalIteration), -1);
 #elif __linux__
         // Until wrapper finishes executing, the runner thread won't be joined when runner's stop() function
         // is called, hence why wrapper is still being registered after runner's stop() is executed.
-        g_ids = es->subscribe("runner", &(::internalIteration));
+        g_ids = es->subscribe(runnerKey, &(::internalIteration), -1);
 #endif
 #endif
 #ifdef DIRECT_RUNNER_I
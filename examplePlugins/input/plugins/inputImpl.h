@@ -12,7 +12,7 @@
 #endif
 
 #include "input.h"
-#include <thread>
+#include <future>
 
 class InputImpl : public Input
 {
@@ -28,7 +28,7 @@ class InputImpl : public Input
     bool pop(const InputDesc& desc);
 #endif
 
-    std::thread thread;
+    std::future<void> loop;
 };
 
 // Helper struct that simplifies the InputDesc sorting process in our implementation, based on keyboard update priority.
@@ -4,10 +4,16 @@
 // Convenience macros to define how the runner will call functions that are pushed/subscribed to it. These are not necessary
 // for developing custom plugins, they exist to more clearly highlight more options for structuring a plugin. 
 //#define EVENT_SYNC_R // Calls each handler in the runner event one-at-a-time, in sequence, per tick.
-#define EVENT_ASYNC_R // Spawns new threads for each handler in runner to be executed in, per tick
+#define EVENT_ASYNC_R // Runs the handlers in runner concurrently on the shared worker pool, per tick.
+//#define EVENT_DISPATCH_R // Dispatch the runner event to the shared worker pool at the start of each tick, and only wait for its handlers at the end of it, so they overlap the RunnerDescs.
 //#define EVENT_MULTI_R // Utilize the runner event in multiple different threads.
 #define DIRECT_R // Call each RunnerDesc registered to the loaded Runner plugin per tick for updating.
 
+// Phase of the runner tick in which the queues of posted Events (see EventStream::post) are drained. Posted Events can also (or
+// instead) be drained by the container's dedicated dispatcher thread; see event_dispatcher in startup.cfg.
+//#define DRAIN_POSTED_BEFORE_R // Drain the posted Events at the start of each tick, before the runner event and RunnerDescs are updated.
+#define DRAIN_POSTED_AFTER_R // Drain the posted Events at the end of each tick, after the runner event and RunnerDescs are updated.
+
 #include "plugin.h"
 #include <vector>
 #include <functional>
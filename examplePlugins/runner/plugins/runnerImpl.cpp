@@ -16,23 +16,29 @@
 #include <string.h>
 
 #include "runnerImpl.h"
+#include "taskExecutor.h"
 
-#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_MULTI_R)
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R) || defined(DRAIN_POSTED_BEFORE_R) || defined(DRAIN_POSTED_AFTER_R)
 #include "event.h"
 #endif
 
-#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_MULTI_R)
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R) || defined(DRAIN_POSTED_BEFORE_R) || defined(DRAIN_POSTED_AFTER_R)
 EventStream<double>* es;
 #endif
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R)
+constexpr EventKey runnerKey("runner");
+EventStream<double>::EventRef runnerEvent;
+#endif
 #ifdef DIRECT_R
 std::vector<RunnerDesc> Runner::descriptors;
 #endif
+TaskExecutor* executor;
 
 std::atomic<bool> breakLoop = false;
 std::atomic<bool> g_block = false;
 std::atomic<bool> g_start = true;
 std::atomic<bool> g_stop = false;
-std::thread t1, t2;
+std::future<void> t1, t2;
 
 #ifdef EVENT_MULTI_R
 void callAsyncWrapper(std::chrono::high_resolution_clock::time_point lastTime)
@@ -45,7 +51,7 @@ void callAsyncWrapper(std::chrono::high_resolution_clock::time_point lastTime)
         std::chrono::high_resolution_clock::time_point currentTime = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(currentTime - lastTime).count();
 
-        es->callAsync("runner", elapsed);
+        es->callAsync(runnerEvent, elapsed);
     }
 }
 #endif
@@ -54,9 +60,14 @@ void callAsyncWrapper(std::chrono::high_resolution_clock::time_point lastTime)
 void RunnerImpl::initialize(size_t identifier)
 {
     std::cout << "RunnerImpl::initialize" << std::endl;
-#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_MULTI_R)
+    executor = TaskExecutor::Instance(identifier);
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R) || defined(DRAIN_POSTED_BEFORE_R) || defined(DRAIN_POSTED_AFTER_R)
     es = EventStream<double>::Instance(identifier);
-    es->create("runner");
+#endif
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R)
+    es->create(runnerKey);
+    // Resolve the runner event once so that the update loop publishes to it without any name lookups.
+    runnerEvent = es->resolve(runnerKey);
 #endif
 }
 
@@ -64,8 +75,11 @@ void RunnerImpl::initialize(size_t identifier)
 void RunnerImpl::release()
 {
     std::cout << "RunnerImpl::release" << std::endl;
-#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_MULTI_R)
-    es->destroy("runner");
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R)
+    runnerEvent = EventStream<double>::EventRef();
+    es->destroy(runnerKey);
+#endif
+#if defined(EVENT_SYNC_R) || defined(EVENT_ASYNC_R) || defined(EVENT_DISPATCH_R) || defined(EVENT_MULTI_R) || defined(DRAIN_POSTED_BEFORE_R) || defined(DRAIN_POSTED_AFTER_R)
     es->requestDelete();
     es = nullptr;
 #endif
@@ -74,7 +88,7 @@ void RunnerImpl::release()
 #endif
 }
 
-// Start the runner plugin in a separate thread. Only used on the C++ end; for some reason python bindings on start() don't work (because 
+// Start the runner plugin's update loop on a thread managed by the shared task executor. Only used on the C++ end; for some reason python bindings on start() don't work (because 
 // python bindings on functions that create new worker threads in general aren't allowed, from what I understand), so we instead have those
 // bindings for start2, which doesn't spawn a separate worker thread .
 void RunnerImpl::start()
@@ -84,10 +98,10 @@ void RunnerImpl::start()
     g_start = true;
     std::cout << "RunnerImpl::start" << std::endl;
     
-    thread = std::thread(&RunnerImpl::start2, RunnerImpl());
+    loop = executor->asyncLongRunning([]() { RunnerImpl().start2(); });
 }
 
-// Breaks the update loop and joins the runner thread.
+// Breaks the update loop and waits for the runner loop to return.
 void RunnerImpl::stop()
 {
     // Since runner is executed on a separate loop, wait for its start() function to complete
@@ -97,16 +111,16 @@ void RunnerImpl::stop()
     std::cout << "RunnerImpl::stop" << std::endl;
     stop2();
 #ifdef EVENT_MULTI_R
-    if (t1.joinable())
+    if (t1.valid())
     {
-        t1.join();
+        t1.wait();
     }
-    if (t2.joinable())
+    if (t2.valid())
     {
-        t2.join();
+        t2.wait();
     }
 #endif
-    thread.join();
+    loop.wait();
     g_stop = false;
 }
 
@@ -130,11 +144,10 @@ void RunnerImpl::start2()
     // python bindings. If we wish to have multithreading on the python end, we need to implement that functionality
     // natively using python, not through bindings/C++.
 #ifdef EVENT_MULTI_R
-    // Here we call the callAsyncWrapper in two separate threads. Recall that all event-calling functions have mutex locks, and
-    // since we're attempting to call runner's handlers in two separate threads, the mutex locks will force one of the threads
-    // to wait for the other thread to finish execution before it can run callAsyncWrapper.
-    t1 = std::thread(callAsyncWrapper, lastTime);
-    t2 = std::thread(callAsyncWrapper, lastTime);
+    // Here we call the callAsyncWrapper in two separate executor-managed threads. Since calling an Event only reads its published
+    // handler snapshot, both threads dispatch runner's handlers concurrently without waiting on one another.
+    t1 = executor->asyncLongRunning([lastTime]() { callAsyncWrapper(lastTime); });
+    t2 = executor->asyncLongRunning([lastTime]() { callAsyncWrapper(lastTime); });
 #endif // EVENT_MULTI_R
 
     while (!breakLoop)
@@ -146,11 +159,17 @@ void RunnerImpl::start2()
         std::chrono::high_resolution_clock::time_point currentTime = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(currentTime - lastTime).count();
 
+#ifdef DRAIN_POSTED_BEFORE_R
+        es->drainPosted();
+#endif
+
 #ifdef EVENT_SYNC_R
-        es->call("runner", elapsed);
+        es->call(runnerEvent, elapsed);
 #elif defined(EVENT_ASYNC_R)
-        es->callAsync("runner", elapsed);
-#endif // EVENT_SYNC_R or EVENT_ASYNC_R
+        es->callAsync(runnerEvent, elapsed);
+#elif defined(EVENT_DISPATCH_R)
+        Completion tick = es->dispatch(runnerEvent, elapsed);
+#endif // EVENT_SYNC_R, EVENT_ASYNC_R or EVENT_DISPATCH_R
 
 #ifdef DIRECT_R
         for (int i = 0; i < Runner::descriptors.size(); ++i)
@@ -166,6 +185,15 @@ void RunnerImpl::start2()
         }
 #endif // DIRECT_R
 
+#ifdef EVENT_DISPATCH_R
+        // The runner event's handlers may still be running; don't start the next tick before they're done.
+        tick.wait();
+#endif
+
+#ifdef DRAIN_POSTED_AFTER_R
+        es->drainPosted();
+#endif
+
         lastTime = currentTime;
     }
 }
@@ -12,7 +12,7 @@
 #endif
 
 #include "runner.h"
-#include <thread>
+#include <future>
 
 class RunnerImpl : public Runner
 {
@@ -29,7 +29,7 @@ class RunnerImpl : public Runner
     bool pop(RunnerDesc desc);
 #endif
 
-    std::thread thread;
+    std::future<void> loop;
 };
 
 // Helper struct that simplifies the RunnerDesc sorting process in our implementation.
@@ -0,0 +1,239 @@
+#ifndef COMPLETION_H
+#define COMPLETION_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "container.h"
+
+// Completion is a lightweight, copyable token for work that runs on the container's worker pool without the caller waiting
+// for it, e.g. an Event dispatched with EventStream::dispatch. The token becomes ready once every task it tracks has finished,
+// and can be polled with isReady(), waited on with wait(), or combined with other tokens through whenAll(). Unlike an
+// std::future obtained from std::async, dropping a Completion never blocks: the tasks simply keep running.
+// A default-constructed Completion tracks nothing and is always ready.
+// A Completion doubles as a cooperative cancellation token: cancel() asks the tracked tasks to stop, which tasks that haven't
+// started yet do by not running at all, while running ones have to check Completion::current().isCancelled() themselves.
+class Completion
+{
+public:
+    Completion() = default;
+
+    // A token that becomes ready once complete() has been called count times. While waiting, wait() helps the container's
+    // worker pool with queued tasks.
+    Completion(Container* container, size_t count)
+        : m_state(std::make_shared<State>(container, count))
+    {
+        if (count == 0)
+        {
+            m_state->finish();
+        }
+    }
+
+    // Whether every tracked task has finished. Never blocks.
+    bool isReady() const
+    {
+        return m_state == nullptr || m_state->done.load(std::memory_order_acquire);
+    }
+
+    // Block until every tracked task has finished, then rethrow the first exception one of them threw, if any. While tasks are
+    // still queued, the waiting thread runs them itself, so waiting from a pool thread doesn't starve the tasks it waits on.
+    void wait() const
+    {
+        if (m_state == nullptr)
+        {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_state->mutex);
+        while (!m_state->done.load(std::memory_order_acquire))
+        {
+            lock.unlock();
+            bool ranTask = m_state->container != nullptr && m_state->container->runPendingTask();
+            lock.lock();
+            if (!ranTask)
+            {
+                m_state->condition.wait(lock, [this] { return m_state->done.load(std::memory_order_acquire); });
+            }
+        }
+        if (m_state->error)
+        {
+            std::rethrow_exception(m_state->error);
+        }
+    }
+
+    // Ask the tracked tasks to stop early. Never blocks, and doesn't make the token ready by itself. Cancelling a token made by
+    // whenAll cancels every token it was made of.
+    void cancel() const
+    {
+        if (m_state != nullptr)
+        {
+            m_state->cancel();
+        }
+    }
+
+    bool isCancelled() const
+    {
+        return m_state != nullptr && m_state->cancelled.load(std::memory_order_acquire);
+    }
+
+    // The token of the task the calling thread is running (see Scope), so that a handler can poll whether it should give up
+    // early. A handler running outside of such a task gets a default token, which is never cancelled.
+    static Completion current()
+    {
+        return t_current != nullptr ? *t_current : Completion();
+    }
+
+    // Makes a token the calling thread's current() one for as long as the Scope lives. Used by whoever runs the tracked tasks.
+    class Scope
+    {
+    public:
+        explicit Scope(const Completion& completion)
+            : m_previous(t_current)
+        {
+            t_current = &completion;
+        }
+
+        ~Scope()
+        {
+            t_current = m_previous;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const Completion* m_previous;
+    };
+
+    // Mark one of the tracked tasks as finished, optionally with the exception it threw. Called by whoever runs the tasks.
+    void complete(std::exception_ptr error = nullptr) const
+    {
+        if (m_state != nullptr)
+        {
+            m_state->complete(error);
+        }
+    }
+
+    // A token that becomes ready once all the given tokens are ready. It carries the first exception reported by any of them,
+    // and cancelling it cancels all of them.
+    static Completion whenAll(const std::vector<Completion>& completions)
+    {
+        Container* container = nullptr;
+        for (const Completion& completion : completions)
+        {
+            if (completion.m_state != nullptr)
+            {
+                container = completion.m_state->container;
+                break;
+            }
+        }
+
+        // The extra count keeps the combined token from becoming ready before every input has been linked to it.
+        Completion all(container, completions.size() + 1);
+        for (const Completion& completion : completions)
+        {
+            if (completion.m_state == nullptr)
+            {
+                all.complete();
+            }
+            else
+            {
+                all.m_state->sources.push_back(completion.m_state);
+                completion.m_state->then(all.m_state);
+            }
+        }
+        all.complete();
+        return all;
+    }
+
+private:
+    struct State
+    {
+        State(Container* _container, size_t count)
+            : container(_container), remaining(count)
+        {}
+
+        void complete(std::exception_ptr taskError)
+        {
+            if (taskError)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                {
+                    error = taskError;
+                }
+            }
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                finish();
+            }
+        }
+
+        void finish()
+        {
+            std::vector<std::shared_ptr<State>> waiting;
+            std::exception_ptr finalError;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.store(true, std::memory_order_release);
+                waiting.swap(dependents);
+                finalError = error;
+                condition.notify_all();
+            }
+            for (const auto& dependent : waiting)
+            {
+                dependent->complete(finalError);
+            }
+        }
+
+        void cancel()
+        {
+            cancelled.store(true, std::memory_order_release);
+            for (const auto& source : sources)
+            {
+                if (std::shared_ptr<State> state = source.lock())
+                {
+                    state->cancel();
+                }
+            }
+        }
+
+        // Count down the dependent once this state is done (straight away if it already is).
+        void then(const std::shared_ptr<State>& dependent)
+        {
+            std::exception_ptr finalError;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!done.load(std::memory_order_relaxed))
+                {
+                    dependents.push_back(dependent);
+                    return;
+                }
+                finalError = error;
+            }
+            dependent->complete(finalError);
+        }
+
+        Container* container;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> done = false;
+        std::atomic<bool> cancelled = false;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::exception_ptr error;
+        std::vector<std::shared_ptr<State>> dependents;
+        // The tokens a whenAll token was made of. Set before the token is handed out, and weak since they refer back to it
+        // (as dependents) until they're done.
+        std::vector<std::weak_ptr<State>> sources;
+    };
+
+    static inline thread_local const Completion* t_current = nullptr;
+
+    std::shared_ptr<State> m_state;
+};
+
+#endif // COMPLETION_H
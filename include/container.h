@@ -5,6 +5,12 @@
     #include <Windows.h>
 #endif
 #include <vector>
+#include <functional>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include "eventKey.h"
+#include "eventMetrics.h"
 
 struct Container
 {
@@ -41,13 +47,17 @@ public:
     virtual void eraseHandle(std::map<std::string, void*>::iterator it) = 0;
     #endif
 
-    virtual std::map<std::string, size_t>& getEventRefCount() = 0;
-    virtual void addEventRefCount(std::string name) = 0;
-    virtual void subtractEventRefCount(std::string name) = 0;
-    virtual void eraseEventRefCount(std::string name) = 0;
-    virtual std::map<std::string, void*>& getEvents() = 0;
-    virtual void addEvent(std::string name, void* ptr_event) = 0;
-    virtual void eraseEvent(std::string name) = 0;
+    // Function set for adding/erasing Events and accessing/altering their reference counts. Events are keyed by the hash of
+    // their names (see eventKey.h). Registering an Event, or adding a reference to one, fails and returns false if the key
+    // collides with an Event that was registered under a different name.
+    virtual std::unordered_map<EventKey::Hash, size_t>& getEventRefCount() = 0;
+    virtual bool addEventRefCount(const EventKey& key) = 0;
+    virtual void subtractEventRefCount(const EventKey& key) = 0;
+    virtual void eraseEventRefCount(const EventKey& key) = 0;
+    virtual std::unordered_map<EventKey::Hash, void*>& getEvents() = 0;
+    virtual void* getEvent(const EventKey& key) = 0;
+    virtual bool addEvent(const EventKey& key, void* ptr_event) = 0;
+    virtual void eraseEvent(const EventKey& key) = 0;
 
     virtual std::map<std::string, size_t>& getEventStreamRefCount() = 0;
     virtual void addEventStreamRefCount(std::string type) = 0;
@@ -56,6 +66,53 @@ public:
     virtual std::map<std::string, void*>& getEventStreams() = 0;
     virtual void addEventStream(std::string type, void* ptr_eventStream) = 0;
     virtual void eraseEventStream(std::string type) = 0;
+
+    // Function set for the work-stealing worker pool shared by all plugins (e.g. for running Event handlers asynchronously).
+    // Plugins normally go through the TaskExecutor helper (taskExecutor.h) rather than calling these directly.
+    virtual size_t getWorkerCount() = 0;
+    virtual void setWorkerCount(size_t count) = 0;
+    virtual void submitTask(std::function<void()> task) = 0;
+    virtual void submitLongRunningTask(std::function<void()> task) = 0;
+    virtual bool runPendingTask() = 0;
+
+    // Function set for the deferred queues of posted Events (see Event::post). Each Event registers its queue the first time
+    // it is posted to; the queues are then drained either by drainPostedQueues() (e.g. in a runner tick phase) or by the
+    // dedicated dispatcher thread, which notifyPosted() wakes up.
+    virtual void addPostedQueue(void* owner, std::function<size_t()> drain) = 0;
+    virtual void erasePostedQueue(void* owner) = 0;
+    virtual size_t drainPostedQueues() = 0;
+    virtual void notifyPosted() = 0;
+    virtual void setPostedDispatcher(bool enabled) = 0;
+
+    // Function set for named executors: dedicated threads, optionally pinned to a core, that each run the tasks submitted to them
+    // in order (e.g. the handlers subscribed with an executor affinity, see Affinity in event.h). getExecutor starts the named
+    // executor if needed and returns the index submitToExecutor takes; currentExecutor returns the calling thread's executor,
+    // or ~0 if it isn't one.
+    virtual size_t getExecutor(const std::string& name, int core) = 0;
+    virtual void submitToExecutor(size_t executor, std::function<void()> task) = 0;
+    virtual size_t currentExecutor() = 0;
+    // Executor affinities of Events read from the configuration file (e.g. "core:2"), which Events pick up when created.
+    virtual void setEventAffinity(const std::string& eventName, const std::string& affinity) = 0;
+    virtual std::string getEventAffinity(const std::string& eventName) = 0;
+
+    // Function set for the watchdog that flags Event handlers overrunning the deadline of their dispatch (see
+    // EventStream::setDeadline). onOverrun is called on the watchdog's thread once the deadline passes, unless the returned
+    // ticket is cleared first; once clearDeadline returns, onOverrun is neither running nor going to be called.
+    virtual size_t watchDeadline(std::chrono::steady_clock::time_point deadline, std::function<void()> onOverrun) = 0;
+    virtual void clearDeadline(size_t ticket) = 0;
+    // Name of the plugin the calling thread is running code for, set by the application around each plugin's initialize, start
+    // and stop, so that handlers can be traced back to the plugin that subscribed them. getCurrentPlugin returns nullptr when
+    // unknown; the names it returns stay valid for the lifetime of the container.
+    virtual void setCurrentPlugin(const std::string& pluginName) = 0;
+    virtual const char* getCurrentPlugin() = 0;
+
+    // Function set for Event metrics (see eventMetrics.h). Every Event registers a function reading its metrics when it's
+    // created, so that they can be queried by Event name without knowing the Event's argument types. getEventMetrics returns
+    // false if no Event with that name exists.
+    virtual void addMetricsSource(const EventKey& key, std::function<EventMetrics()> read) = 0;
+    virtual void eraseMetricsSource(const EventKey& key) = 0;
+    virtual bool getEventMetrics(const EventKey& key, EventMetrics& metrics) = 0;
+    virtual std::vector<EventMetrics> getAllEventMetrics() = 0;
 };
 
 #endif // CONTAINER_H
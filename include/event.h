@@ -6,13 +6,33 @@
 #include <functional>
 #include <vector>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <algorithm>
 #include <future>
+#include <memory>
 #include <map>
 #include <string>
 #include <cstdarg>
 #include <type_traits>
+#include <tuple>
+#include <optional>
+#include <deque>
+#include <chrono>
+
+// Coroutine support (EventStream::next/when as awaitables) needs C++20; with C++17 only the callback forms (once/when) exist.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define EVENT_HAS_COROUTINES
+#endif
 
 #include "container.h"
+#include "inlineFunction.h"
+#include "mpscRingBuffer.h"
+#include "epochSnapshot.h"
+#include "sharedPayload.h"
+#include "completion.h"
+#include "topicTrie.h"
 #ifdef _WIN32
 #include <Windows.h>
 #elif __linux__
@@ -21,6 +41,171 @@
 #error define your compiler
 #endif
 
+#ifdef EVENT_HAS_COROUTINES
+// Return type for fire-and-forget coroutines that await Events (see EventStream::next and EventStream::when). The coroutine starts
+// running straight away, and its frame is freed as soon as it finishes. While it's suspended it holds no thread; it's resumed by
+// whichever thread delivers the Event it waits on.
+struct EventTask
+{
+    struct promise_type
+    {
+        EventTask get_return_object() noexcept { return EventTask(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+#endif
+
+// What an Event does with a new queued or asynchronous call once it's at capacity (see EventStream::setQueuePolicy).
+enum class QueuePolicy
+{
+    Block,      // Make the producer wait until there is room (helping the worker pool with its tasks in the meantime).
+    DropOldest, // Discard the oldest undelivered call to make room.
+    DropNewest, // Reject the new call.
+    Coalesce    // Merge the new call into an undelivered call with the same key, replacing its arguments.
+};
+
+// Overload counters of an Event's queued and asynchronous calls (see EventStream::queueStats).
+struct QueueStats
+{
+    size_t overflows = 0; // Calls that found the Event at capacity.
+    size_t dropped = 0;   // Calls discarded, either rejected or evicted to make room.
+    size_t coalesced = 0; // Calls merged into an undelivered one.
+    size_t blocked = 0;   // Times a producer had to wait for room.
+    size_t pending = 0;   // Posted calls waiting to be drained, plus asynchronous calls still to be delivered.
+};
+
+// What the watchdog does about the handlers of a dispatch that are still running (or haven't started) when the dispatch's deadline
+// passes (see EventStream::setDeadline). Whatever the policy, the overrunning handlers are reported, naming the plugin that
+// subscribed them and the Event.
+enum class OverrunPolicy
+{
+    Report, // Only report them.
+    Cancel, // Also cancel the dispatch (see Completion::cancel), which skips the handlers that haven't started yet.
+    Detach  // Also cancel the dispatch, and count the overrunning handlers as finished, so that whoever waits on the dispatch's
+            // Completion stops waiting for them. They keep running in the background, and the Event can't be destroyed until
+            // they return.
+};
+
+// How a rate-limited subscription thins out the calls of a high-rate Event (see EventStream::subscribeLimited). The filtering
+// happens in the dispatcher, before the handler's function is invoked, so the calls a subscription skips cost next to nothing.
+struct RateLimit
+{
+    enum class Kind
+    {
+        Throttle, // Deliver a call, then skip the calls arriving within the next interval.
+        Debounce, // Deliver only the latest call, once no new call has arrived for an interval.
+        Sample,   // Deliver every Nth call.
+        Window    // Deliver the calls of each interval together, as a batch (see EventStream::subscribeWindowed).
+    };
+
+    static RateLimit throttle(std::chrono::nanoseconds interval)
+    {
+        return RateLimit{Kind::Throttle, interval, 1};
+    }
+
+    static RateLimit debounce(std::chrono::nanoseconds interval)
+    {
+        return RateLimit{Kind::Debounce, interval, 1};
+    }
+
+    static RateLimit sample(size_t every)
+    {
+        return RateLimit{Kind::Sample, std::chrono::nanoseconds(0), every == 0 ? 1 : every};
+    }
+
+    static RateLimit window(std::chrono::nanoseconds interval)
+    {
+        return RateLimit{Kind::Window, interval, 1};
+    }
+
+    Kind kind;
+    std::chrono::nanoseconds interval;
+    size_t every;
+};
+
+// Where a handler runs when its Event is called asynchronously (callAsync or dispatch): on the shared worker pool, inline on
+// the thread making the call, or on a named executor, i.e. a dedicated thread that runs its tasks in order, optionally pinned
+// to a CPU core, so that a handler with a lot of state keeps it in a warm cache. Handlers subscribed without an affinity
+// follow their Event's (see EventStream::setAffinity and the event_affinity setting of startup.cfg), which is the pool unless
+// set otherwise. Synchronous calls (call, callBatch, and the drains of posted calls) run every handler on the delivering thread.
+struct Affinity
+{
+    enum class Kind
+    {
+        Default,  // Follow the Event's affinity.
+        Pool,     // Any thread of the shared worker pool.
+        Caller,   // The thread calling the Event.
+        Executor  // The named executor.
+    };
+
+    static Affinity pool()
+    {
+        return Affinity{Kind::Pool, std::string(), -1};
+    }
+
+    static Affinity caller()
+    {
+        return Affinity{Kind::Caller, std::string(), -1};
+    }
+
+    // A named executor, whose thread is pinned to the given core (if it's 0 or more) when it's started.
+    static Affinity executor(const std::string& name, int core = -1)
+    {
+        return Affinity{Kind::Executor, name, core};
+    }
+
+    // The executor pinned to the given core (there is one per core, named "core<N>").
+    static Affinity pinned(int core)
+    {
+        return Affinity{Kind::Executor, "core" + std::to_string(core), core};
+    }
+
+    // Parse an affinity written as in startup.cfg: "pool", "caller", "core:<N>", "executor:<name>" or "executor:<name>:<N>".
+    static std::optional<Affinity> parse(const std::string& text)
+    {
+        if (text == "pool")
+        {
+            return pool();
+        }
+        if (text == "caller")
+        {
+            return caller();
+        }
+
+        size_t colon = text.find(':');
+        std::string kind = text.substr(0, colon);
+        std::string rest = colon == std::string::npos ? std::string() : text.substr(colon + 1);
+        auto toCore = [](const std::string& digits)
+        {
+            return !digits.empty() && digits.size() < 6 && std::all_of(digits.begin(), digits.end(), ::isdigit) ? std::stoi(digits) : -1;
+        };
+        if (kind == "core" && toCore(rest) >= 0)
+        {
+            return pinned(toCore(rest));
+        }
+        if (kind == "executor" && !rest.empty())
+        {
+            size_t coreColon = rest.find(':');
+            if (coreColon == std::string::npos)
+            {
+                return executor(rest);
+            }
+            if (coreColon > 0 && toCore(rest.substr(coreColon + 1)) >= 0)
+            {
+                return executor(rest.substr(0, coreColon), toCore(rest.substr(coreColon + 1)));
+            }
+        }
+        return std::nullopt;
+    }
+
+    Kind kind = Kind::Default;
+    std::string executorName;
+    int core = -1;
+};
+
 // The EventStream class is responsible for managing all Events sharing the same number of arguments/argument types in this 
 // application. It is designed as a singleton so that a single instance stores all Events and their corresponding handles, thus 
 // allowing it to be easily shared/distributed across multiple plugins. If we create an EventStream instance of type double, for
@@ -28,10 +213,19 @@
 // extension handles whose only argument is a type-double variable.
 template <typename... Args> class EventStream
 {
+    static_assert(!(sizeof...(Args) == 1 && std::conjunction_v<std::is_function<Args>...>),
+        "EventStream<R(Args...)> is declared in reduceEventStream.h; include it to use Events whose handlers return values.");
+
+    // Lets EventStream<R(Args...)> (see reduceEventStream.h) reuse the container loaded here.
+    template <typename... Others> friend class EventStream;
+
 private:
     static Container* m_container;
     std::recursive_mutex m_lock;
 
+    // How often destroy() reports an Event whose handlers are taking long to return.
+    static constexpr std::chrono::seconds DestroyReportInterval = std::chrono::seconds(5);
+
     // Use a function signature to obtain the EventStream's templated specialization type.
     static std::string esType(std::string funcSig)
     {
@@ -125,26 +319,240 @@ private:
         #endif
     }
 
+    // Simple count-down latch (std::latch is only available from C++20 onwards) used to wait for a batch of tasks that were
+    // submitted to the container's worker pool.
+    class Latch
+    {
+    public:
+        explicit Latch(size_t count)
+            : m_count(count)
+        {}
+
+        Latch(const Latch&) = delete;
+        Latch& operator=(const Latch&) = delete;
+
+        void countDown()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_count == 0)
+            {
+                m_condition.notify_all();
+            }
+        }
+
+        // Block until the count reaches zero. While tasks are still queued, the waiting thread runs them itself, which keeps
+        // pool threads that wait on nested dispatches from starving the handlers they're waiting on.
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_count > 0)
+            {
+                lock.unlock();
+                bool ranTask = m_container->runPendingTask();
+                lock.lock();
+                if (!ranTask)
+                {
+                    m_condition.wait(lock, [this] { return m_count == 0; });
+                }
+            }
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        size_t m_count;
+    };
+
+    template <typename... Args2> class Event;
+
+    // The type in which batch handlers receive an Event's payloads: the argument itself for single-argument Events (so that e.g.
+    // the handlers of an EventStream<double> get a contiguous array of doubles), and an std::tuple of the arguments otherwise.
+    template <typename... Args2> struct PayloadType
+    {
+        typedef std::tuple<Args2...> type;
+    };
+
+    template <typename Arg> struct PayloadType<Arg>
+    {
+        typedef Arg type;
+    };
+
+    // State shared by every copy of a rate-limited EventHandler. Throttled and sampled calls are let through or skipped on the
+    // calling thread using the atomics alone; debounced and windowed calls are held back here until the Event's rate timer
+    // delivers them.
+    template <typename... Args2> struct RateGate
+    {
+        typedef typename PayloadType<Args2...>::type Payload;
+
+        RateGate(Event<Args2...>* _event, RateLimit _limit)
+            : event(_event), limit(_limit)
+        {}
+
+        Event<Args2...>* event;
+        RateLimit limit;
+        std::atomic<int64_t> nextDelivery = 0; // Throttle: steady_clock time (in ns) before which calls are skipped.
+        std::atomic<size_t> calls = 0;         // Sample: calls seen so far.
+
+        // Debounce/Window: the calls held back, when they are due, and whether the rate timer is due to deliver them.
+        std::mutex lock;
+        std::optional<std::tuple<Args2...>> latest;
+        std::vector<Payload> window;
+        std::chrono::steady_clock::time_point deadline;
+        bool armed = false;
+        std::function<void(const Payload*, size_t)> windowFunc;
+    };
+
+    // The arguments a sticky Event retains from its latest call (see Event::setSticky). Every call of a sticky Event retains its
+    // arguments, so doing so must neither lock nor allocate when it can help it: arguments that are all trivially copyable are
+    // kept in place in a seqlock'd slot, which writers take in turn (briefly spinning on the sequence) and readers copy out of,
+    // retrying if a write overlapped. Other arguments are copied to the heap and published as an EpochSnapshot, the writers
+    // being serialized by a mutex.
+    template <bool Inline, typename... Args2> class StickySlot;
+
+    template <typename... Args2> class StickySlot<true, Args2...>
+    {
+    public:
+        void retain(const Args2&... params)
+        {
+            size_t sequence = beginWrite();
+            m_args = std::tuple<Args2...>(params...);
+            m_retained = true;
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        void clear()
+        {
+            size_t sequence = beginWrite();
+            m_retained = false;
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Call f with the retained arguments, if there are any.
+        template <typename F> void visit(F&& f) const
+        {
+            std::tuple<Args2...> args;
+            bool retained;
+            while (true)
+            {
+                size_t before = m_sequence.load(std::memory_order_acquire);
+                if ((before & 1) != 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                args = m_args;
+                retained = m_retained;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == before) break;
+            }
+            if (retained)
+            {
+                f(args);
+            }
+        }
+
+    private:
+        // Wait for the slot to be free and take it, making the sequence odd. Returns the (even) sequence it had; the writer
+        // releases the slot by storing that sequence + 2.
+        size_t beginWrite()
+        {
+            size_t sequence = m_sequence.load(std::memory_order_relaxed);
+            while ((sequence & 1) != 0 || !m_sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+                sequence = m_sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            return sequence;
+        }
+
+        // Odd while a writer is updating the slot.
+        std::atomic<size_t> m_sequence = 0;
+        std::tuple<Args2...> m_args;
+        bool m_retained = false;
+    };
+
+    template <typename... Args2> class StickySlot<false, Args2...>
+    {
+    public:
+        void retain(const Args2&... params)
+        {
+            const std::tuple<Args2...>* args = new std::tuple<Args2...>(params...);
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            m_args.publish(args);
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            m_args.publish(nullptr);
+        }
+
+        // Call f with the retained arguments, if there are any. They stay alive until f returns.
+        template <typename F> void visit(F&& f) const
+        {
+            typename EpochSnapshot<std::tuple<Args2...>>::ReadGuard guard(m_args);
+            if (guard.get() != nullptr)
+            {
+                f(*guard);
+            }
+        }
+
+    private:
+        std::mutex m_writeLock;
+        EpochSnapshot<std::tuple<Args2...>> m_args{ nullptr };
+    };
+
     // EventHandler is a wrapper class for functions we wish to subscribe to a specific event.
-    // Each EventHandler basically stores the actual function and an associated id.
+    // Each EventHandler basically stores the actual function, a priority (handlers with lower priorities are called first,
+    // like RunnerDescs and InputDescs) and an associated id, which the Event assigns when the handler gets subscribed to it
+    // (0 until then). The function is kept in an InlineFunction with a fixed HandlerCapacity, so copying handlers around
+    // (e.g. when a new snapshot gets published) and calling them does not allocate; only callables larger than
+    // HandlerCapacity are kept on the heap. The capacity is deliberately not configurable, since Events are shared by every
+    // plugin and all of them need to agree on the layout of an EventHandler.
     //template <typename... Args> class EventHandler
     template <typename... Args2> class EventHandler
     {
     public:
+        // Large enough to hold an std::function (so subscribing one never allocates again) or a lambda with a handful of captures.
+        static constexpr size_t HandlerCapacity = 64;
+
+        // Where the handler runs when its Event is called asynchronously: an index returned by Container::getExecutor, or one of
+        // these (see Affinity).
+        static constexpr size_t DefaultExecutor = ~size_t(0);
+        static constexpr size_t PoolExecutor = ~size_t(0) - 1;
+        static constexpr size_t CallerExecutor = ~size_t(0) - 2;
+
+        // Construct from an std::function. If it simply wraps a function pointer, store the pointer itself to skip a layer of indirection.
         explicit EventHandler(const std::function<void(Args2...)>& handlerFunc)
-            : m_handlerFunc(handlerFunc)
         {
-            m_handlerId = ++m_handlerIdCounter;
+            if (auto funcPtr = handlerFunc.template target<void(*)(Args2...)>())
+            {
+                m_handlerFunc = *funcPtr;
+            }
+            else
+            {
+                m_handlerFunc = handlerFunc;
+            }
         }
 
+        // Construct from any other callable (function pointer, lambda, functor) without going through an std::function.
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, EventHandler<Args2...>>
+            && !std::is_same_v<std::decay_t<F>, std::function<void(Args2...)>> && std::is_invocable_v<std::decay_t<F>&, const Args2&...>>>
+        explicit EventHandler(F&& handlerFunc)
+            : m_handlerFunc(std::forward<F>(handlerFunc))
+        {}
+
         // Copy constructor.
         EventHandler(const EventHandler<Args2...>& src)
-            : m_handlerFunc(src.m_handlerFunc), m_handlerId(src.m_handlerId)
+            : m_handlerId(src.m_handlerId), m_priority(src.m_priority), m_handlerFunc(src.m_handlerFunc), m_gate(src.m_gate),
+            m_executor(src.m_executor), m_owner(src.m_owner), m_recorder(src.m_recorder)
         {}
 
         // Move constructor.
-        EventHandler(EventHandler<Args2...>&& src)
-            : m_handlerFunc(std::move(src.m_handlerFunc)), m_handlerId(src.m_handlerId)
+        EventHandler(EventHandler<Args2...>&& src) noexcept
+            : m_handlerId(src.m_handlerId), m_priority(src.m_priority), m_handlerFunc(std::move(src.m_handlerFunc)),
+            m_gate(std::move(src.m_gate)), m_executor(src.m_executor), m_owner(src.m_owner), m_recorder(std::move(src.m_recorder))
         {}
 
         size_t id() const
@@ -152,13 +560,24 @@ private:
             return m_handlerId;
         }
 
-        // Function call operator.
-        void operator()(Args2... params) const
+        int priority() const
         {
-            if (m_handlerFunc)
+            return m_priority;
+        }
+
+        // Function call operator. The arguments are passed on by const reference, so they are only copied if the handler itself
+        // takes them by value.
+        void operator()(const Args2&... params) const
+        {
+            if (m_gate != nullptr && !m_gate->event->admit(m_gate, params...))
+            {
+                return;
+            }
+            if (!m_handlerFunc)
             {
-                m_handlerFunc(params...);
+                return;
             }
+            timed([&] { m_handlerFunc(params...); });
         }
 
         // Event handler comparison operator.
@@ -173,23 +592,92 @@ private:
             if (&src == this) return *this;
             m_handlerFunc = src.m_handlerFunc;
             m_handlerId = src.m_handlerId;
+            m_priority = src.m_priority;
+            m_gate = src.m_gate;
+            m_executor = src.m_executor;
+            m_owner = src.m_owner;
+            m_recorder = src.m_recorder;
 
             return *this;
         }
 
         // Move assignment operator.
-        EventHandler<Args2...>& operator=(EventHandler<Args2...>&& src)
+        EventHandler<Args2...>& operator=(EventHandler<Args2...>&& src) noexcept
         {
             std::swap(m_handlerFunc, src.m_handlerFunc);
             m_handlerId = src.m_handlerId;
+            m_priority = src.m_priority;
+            std::swap(m_gate, src.m_gate);
+            m_executor = src.m_executor;
+            m_owner = src.m_owner;
+            std::swap(m_recorder, src.m_recorder);
 
             return *this;
         }
 
     private:
-        size_t m_handlerId;
-        std::function<void(Args2...)> m_handlerFunc;
-        static inline std::atomic_uint m_handlerIdCounter = 0;
+        friend class Event<Args2...>;
+
+        // Deliver a call to the handler through run, recording how long it took if the handler is timed. Every delivery goes
+        // through here, including those of held-back calls that bypass operator() (see Event::flushRate).
+        template <typename F> void timed(F&& run) const
+        {
+            if (m_recorder == nullptr)
+            {
+                run();
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            run();
+            m_recorder->record(std::chrono::steady_clock::now() - start);
+        }
+
+        size_t m_handlerId = 0;
+        int m_priority = 0;
+        InlineFunction<void(const Args2&...), HandlerCapacity> m_handlerFunc;
+        // Set for rate-limited handlers only (see Event::addLimited).
+        std::shared_ptr<RateGate<Args2...>> m_gate;
+        size_t m_executor = DefaultExecutor;
+        // Name of the plugin that subscribed the handler, if known (see Container::getCurrentPlugin).
+        const char* m_owner = nullptr;
+        // Invocation count and latency histogram, shared by the copies of the handler in every snapshot (see Event::metrics).
+        // Set when the handler gets subscribed; handlers that were never subscribed aren't timed.
+        std::shared_ptr<HandlerRecorder> m_recorder;
+    };
+
+    // EventBatchHandler is the counterpart of EventHandler for functions that consume an Event's payloads a whole batch at a time,
+    // i.e. that take a pointer to a contiguous array of payloads and its length. Batch handlers share the Event's id space with
+    // regular handlers, so they are unsubscribed the same way.
+    template <typename... Args2> class EventBatchHandler
+    {
+    public:
+        typedef typename PayloadType<Args2...>::type Payload;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, EventBatchHandler<Args2...>>
+            && std::is_invocable_v<std::decay_t<F>&, const Payload*, size_t>>>
+        explicit EventBatchHandler(F&& handlerFunc)
+            : m_handlerFunc(std::forward<F>(handlerFunc))
+        {}
+
+        size_t id() const
+        {
+            return m_handlerId;
+        }
+
+        // Function call operator.
+        void operator()(const Payload* payloads, size_t count) const
+        {
+            if (m_handlerFunc)
+            {
+                m_handlerFunc(payloads, count);
+            }
+        }
+
+    private:
+        friend class Event<Args2...>;
+
+        size_t m_handlerId = 0;
+        InlineFunction<void(const Payload*, size_t), EventHandler<Args2...>::HandlerCapacity> m_handlerFunc;
     };
 
     // The Event class forms the meat-and-potatoes of the event system. Every instantiated Event object can be specialized to accept 
@@ -197,8 +685,68 @@ private:
     // a list of EventHandlers that can be called in a variety of ways, so every time an Event is triggered/ran it actually ends up calling
     // the corresponding subscribed handles. Similarly, EventHandlers can be unsubscribed from an Event so that they are no longer called
     // whenever an Event is ran.
+    // The list of handlers is stored as an immutable snapshot that is atomically published. Calling an Event only registers itself as
+    // a reader of the current snapshot (no locking, copying or spinning), while subscribing/unsubscribing builds a new snapshot, swaps
+    // it in, and retires the old one. Retired snapshots are reclaimed once every reader that could still be using them has finished
+    // (epoch-based reclamation, see EpochSnapshot).
+    // Handler ids are handles into a generational slot map: the low SlotBits bits of an id select a slot, which records where the
+    // handler currently sits in the (densely-packed, subscription-ordered) handler list, and the remaining bits hold the generation
+    // the slot had when the handler was added. Unsubscribing by id is therefore a constant-time slot lookup rather than a search,
+    // and ids of handlers that were already removed (or that belong to another Event) are detected by their generation mismatch.
+    // The handler list is kept sorted by priority: each handler is inserted after every handler whose priority is lower or equal
+    // when it's subscribed, so handlers with equal priorities run in subscription order and calls never have to sort anything.
+    // Besides per-call EventHandlers, an Event can hold EventBatchHandlers, which are handed every payload of a delivery at once:
+    // all the calls posted since the last drain, a callBatch's whole batch, or the single payload of a plain call.
     template <typename... Args2> class Event
     {
+    private:
+        typedef typename PayloadType<Args2...>::type Payload;
+
+        // Rate-limited handlers consult the Event (see admit) before running.
+        friend class EventHandler<Args2...>;
+
+        static constexpr size_t SlotBits = 24;
+        static constexpr size_t SlotMask = (size_t(1) << SlotBits) - 1;
+        static constexpr size_t NoIndex = ~size_t(0);
+
+        // Slot map entry. Generations are drawn from a counter shared by all Events with the same signature, so that every
+        // id ever handed out is unique; index is the handler's position in the handler list, or NoIndex when the slot is free.
+        struct Slot
+        {
+            size_t generation;
+            size_t index;
+        };
+
+        // Immutable list of handlers published by the Event.
+        struct HandlerSnapshot
+        {
+            std::vector<EventHandler<Args2...>> handlers;
+            std::vector<EventBatchHandler<Args2...>> batchHandlers;
+        };
+
+        // RAII helper that registers the current thread as a reader of the Event's published snapshot. The snapshot
+        // is guaranteed to stay alive for as long as the guard exists.
+        class ReadGuard
+        {
+        public:
+            explicit ReadGuard(const Event<Args2...>& event)
+                : m_guard(event.m_snapshot)
+            {}
+
+            const std::vector<EventHandler<Args2...>>& handlers() const
+            {
+                return m_guard->handlers;
+            }
+
+            const std::vector<EventBatchHandler<Args2...>>& batchHandlers() const
+            {
+                return m_guard->batchHandlers;
+            }
+
+        private:
+            typename EpochSnapshot<HandlerSnapshot>::ReadGuard m_guard;
+        };
+
     public:
         // Default constructor.
         Event()
@@ -209,47 +757,87 @@ private:
         // Copy constructor.
         Event(const Event<Args2...>& src)
         {
-            std::lock_guard<std::recursive_mutex> lock(src.m_handlersLocker);
-
-            m_handlers = src.m_handlers;
+            std::vector<EventHandler<Args2...>> handlers = src.getHandlersCopy();
+            std::vector<EventBatchHandler<Args2...>> batchHandlers = src.getBatchHandlersCopy();
+            rebuildSlots(handlers, batchHandlers);
+            publish(std::move(handlers), std::move(batchHandlers));
         }
 
         // Move constructor.
         Event(Event<Args2...>&& src)
         {
-            std::lock_guard<std::recursive_mutex> lock(src.m_handlersLocker);
+            std::vector<EventHandler<Args2...>> handlers = src.getHandlersCopy();
+            std::vector<EventBatchHandler<Args2...>> batchHandlers = src.getBatchHandlersCopy();
+            rebuildSlots(handlers, batchHandlers);
+            publish(std::move(handlers), std::move(batchHandlers));
+        }
 
-            m_handlers = std::move(src.m_handlers);
+        // Destructor. The owner (EventStream::destroy) is responsible for waiting until isExecutionComplete() before deleting an Event.
+        ~Event()
+        {
+            m_alive->store(false, std::memory_order_release);
+            {
+                std::unique_lock<std::mutex> lock(m_rateTimer.lock);
+                m_rateTimer.stop = true;
+                m_rateTimer.condition.notify_all();
+                m_rateTimer.condition.wait(lock, [this] { return !m_rateTimer.running; });
+            }
+            if (m_postRegistered.load())
+            {
+                m_container->erasePostedQueue(this);
+            }
+            delete m_postQueue.load();
+            delete[] m_orderedLanes.load();
         }
 
         // Add an EventHandler to the current Event. Return a size_t id that uniquely identifies the handler.
         size_t add(const EventHandler<Args2...>& handler)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before subscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
+            size_t id;
+            {
+                std::lock_guard<std::mutex> lock(m_writeLock);
+
+                std::vector<EventHandler<Args2...>> handlers = m_snapshot.load()->handlers;
+                id = attach(handlers, handler);
+                publish(std::move(handlers));
+            }
+            replaySticky(id);
+            return id;
+        }
+
+        // Add an EventHandler to the current Event with the given priority (lower priorities are called first). Return a size_t id
+        // that uniquely identifies the handler.
+        size_t add(EventHandler<Args2...> handler, int priority)
+        {
+            size_t id;
+            {
+                std::lock_guard<std::mutex> lock(m_writeLock);
 
-            isSubscriptionComplete = false;
-            m_handlers.push_back(handler);
-            isSubscriptionComplete = true;
-            return handler.id();
+                handler.m_priority = priority;
+                std::vector<EventHandler<Args2...>> handlers = m_snapshot.load()->handlers;
+                id = attach(handlers, std::move(handler));
+                publish(std::move(handlers));
+            }
+            replaySticky(id);
+            return id;
         }
 
         // Add a vector of EventHandlers to the current Event. Return a vector of size_t ids that uniquely identify all subscribed handlers.
         std::vector<size_t> add(const std::vector<EventHandler<Args2...>>& handlers)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before subscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isSubscriptionComplete = false;
             std::vector<size_t> _ids; _ids.reserve(handlers.size());
-            for (int i = 0; i < handlers.size(); ++i)
             {
-                m_handlers.push_back(handlers[i]);
-                _ids.push_back(handlers[i].id());
+                std::lock_guard<std::mutex> lock(m_writeLock);
+
+                std::vector<EventHandler<Args2...>> _handlers = m_snapshot.load()->handlers;
+                _handlers.reserve(_handlers.size() + handlers.size());
+                for (size_t i = 0; i < handlers.size(); ++i)
+                {
+                    _ids.push_back(attach(_handlers, handlers[i]));
+                }
+                publish(std::move(_handlers));
             }
-            isSubscriptionComplete = true;
+            replaySticky(_ids);
             return _ids;
         }
 
@@ -257,8 +845,6 @@ private:
         // identifies the handler.
         size_t add(const std::function<void(Args2...)>& handler)
         {
-            //std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
             return add(EventHandler<Args2...>(handler));
         }
 
@@ -266,517 +852,2995 @@ private:
         // that uniquely identify all subscribed handlers.
         std::vector<size_t> add(const std::vector<std::function<void(Args2...)>>& handlers)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before subscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isSubscriptionComplete = false;
             std::vector<size_t> _ids; _ids.reserve(handlers.size());
-            for (int i = 0; i < handlers.size(); ++i)
             {
-                EventHandler<Args2...> _eh(handlers[i]);
-                m_handlers.push_back(_eh);
-                _ids.push_back(_eh.id());
+                std::lock_guard<std::mutex> lock(m_writeLock);
+
+                std::vector<EventHandler<Args2...>> _handlers = m_snapshot.load()->handlers;
+                _handlers.reserve(_handlers.size() + handlers.size());
+                for (size_t i = 0; i < handlers.size(); ++i)
+                {
+                    _ids.push_back(attach(_handlers, EventHandler<Args2...>(handlers[i])));
+                }
+                publish(std::move(_handlers));
             }
-            isSubscriptionComplete = true;
+            replaySticky(_ids);
             return _ids;
         }
 
-        // Remove an EventHandler from the Event by searching for the handle specifically.
-        void remove(const EventHandler<Args2...>& handler)
+        // Add an EventBatchHandler to the current Event. Return a size_t id that uniquely identifies the handler (and that can be
+        // passed to remove_id like the id of any other handler).
+        size_t addBatch(const EventBatchHandler<Args2...>& handler)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before unsubscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isUnsubscriptionComplete = false;
-            auto it = std::find(m_handlers.begin(), m_handlers.end(), handler);
-            if (it != m_handlers.end())
+            size_t id;
             {
-                m_handlers.erase(it);
+                std::lock_guard<std::mutex> lock(m_writeLock);
+
+                const HandlerSnapshot* current = m_snapshot.load();
+                std::vector<EventBatchHandler<Args2...>> batchHandlers = current->batchHandlers;
+                id = attach(batchHandlers, handler);
+                publish(current->handlers, std::move(batchHandlers));
             }
-            isUnsubscriptionComplete = true;
+            replaySticky(id);
+            return id;
         }
 
-        // Remove all EventHandlers in the input vector by searching for the handle specifically.
-        void remove(const std::vector<EventHandler<Args2...>>& handlers)
+        // Add a handler that runs f only once, for the first call whose arguments satisfy pred, and then removes itself. Returns
+        // its id, which can be passed to remove_id to cancel it before it runs. pred may be evaluated concurrently when the Event
+        // is called from several threads (or asynchronously), but f runs for exactly one call.
+        template <typename Pred, typename F> size_t addOnce(Pred pred, F f)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before unsubscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isUnsubscriptionComplete = false;
-            for (int i = 0; i < handlers.size(); ++i)
+            std::shared_ptr<OnceState<Pred, F>> once = std::make_shared<OnceState<Pred, F>>(std::move(pred), std::move(f));
+            size_t id = add(EventHandler<Args2...>([this, once](const Args2&... params)
             {
-                auto it = std::find(m_handlers.begin(), m_handlers.end(), handlers[i]);
-                if (it != m_handlers.end())
+                if (once->fired.load(std::memory_order_acquire) || !once->pred(params...) || once->fired.exchange(true))
                 {
-                    m_handlers.erase(it);
+                    return;
                 }
-            }
-            isUnsubscriptionComplete = true;
-        }
-
-        // Remove an EventHandler from the Event by searching for the handle's id.
-        void remove_id(const size_t& handlerId)
-        {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before unsubscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
+                // If add() hasn't returned yet, the subscribing thread removes the handler once it does.
+                size_t id = once->id.exchange(OnceFired);
+                if (id != 0)
+                {
+                    remove_id(id);
+                }
+                once->f(params...);
+            }));
 
-            isUnsubscriptionComplete = false;
-            auto it = std::find_if(m_handlers.begin(), m_handlers.end(), [handlerId](const EventHandler<Args2...>& handler) { return handler.id() == handlerId; });
-            if (it != m_handlers.end())
+            size_t expected = 0;
+            if (!once->id.compare_exchange_strong(expected, id))
             {
-                m_handlers.erase(it);
+                remove_id(id);
             }
-            isUnsubscriptionComplete = true;
+            return id;
         }
 
-        // Remove all EventHandlers in the input argument list from the Event by searching for each handle's id.
-        void remove_id(const std::vector<size_t>& handlerIds)
+        // Add an EventHandler that runs where the given affinity says when the Event is called asynchronously (see Affinity).
+        // Return a size_t id that uniquely identifies the handler.
+        size_t add(EventHandler<Args2...> handler, const Affinity& affinity)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before unsubscribing any new functions.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isUnsubscriptionComplete = false;
-            for (int i = 0; i < handlerIds.size(); ++i)
-            {
-                size_t _id = handlerIds[i];
-                auto it = std::find_if(m_handlers.begin(), m_handlers.end(), [_id](const EventHandler<Args2...>& handler) { return handler.id() == _id; });
-                if (it != m_handlers.end())
-                {
-                    m_handlers.erase(it);
-                }
-            }
-            isUnsubscriptionComplete = true;
+            handler.m_executor = toExecutor(affinity);
+            return add(handler);
         }
 
-        // Sequentially/synchronously call each EventHandler in this Event.
-        void call(Args2... params)
+        // Give every dispatch of the Event a deadline (see dispatchWithin). A budget of zero removes it.
+        void setDeadline(std::chrono::nanoseconds budget, OverrunPolicy policy)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before calling any functions again.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isExecutionComplete = false;
-            std::vector<EventHandler<Args2...>> handlersCopy = getHandlersCopy();
-            callImpl(handlersCopy, params...);
-            isExecutionComplete = true;
+            m_overrunPolicy.store(policy, std::memory_order_relaxed);
+            m_deadline.store(budget.count(), std::memory_order_relaxed);
         }
 
-        // Allows one to run this Event in multiple threads.
-        std::future<void> callAsyncBlocking(Args2... params)
+        // The name the Event was created with, for diagnostics.
+        const std::string& name() const
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before calling any functions again.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            return std::async(std::launch::async, [this](Args2... asyncParams)
-            { call(asyncParams...); }, params...);
+            return m_name;
         }
 
-        // Run each EventHandler subscribed to this Event in a separate thread.
-        void callAsync(Args2... params)
+        void setName(const std::string& name)
         {
-            // Wait for current execution cycle and any other subscription/unsubscription services to finish before calling any functions again.
-            while (!isExecutionComplete || !isSubscriptionComplete || !isUnsubscriptionComplete) continue;
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            isExecutionComplete = false;
-            callAsyncImpl(m_handlers, params...);
-            isExecutionComplete = true;
+            m_name = name;
         }
 
-        // Returns a copy of the Event's std::vector of EventHandlers. 
-        std::vector<EventHandler<Args2...>> getHandlersCopy() const
+        // Set where the handlers subscribed without an affinity of their own run when the Event is called asynchronously.
+        void setAffinity(const Affinity& affinity)
         {
-            // TODO: This line seemed to be the issue when it came to input halting from time-to-time.
-            //std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-
-            // Since the function return value is by copy, 
-            // before the function returns (and destruct the lock_guard object),
-            // it creates a copy of the m_handlers container.
-            return m_handlers;
+            size_t executor = toExecutor(affinity);
+            m_defaultExecutor.store(executor == EventHandler<Args2...>::DefaultExecutor ? EventHandler<Args2...>::PoolExecutor : executor,
+                std::memory_order_relaxed);
+        }
+
+        // Add a handler whose calls are thinned out by a Throttle, Debounce or Sample limit, and return its id. Throttled and sampled
+        // calls reach the handler on the calling thread, like any other; a debounced handler is called on the Event's rate timer
+        // thread, once the calls have gone quiet for the limit's interval.
+        template <typename F> size_t addLimited(RateLimit limit, F f)
+        {
+            if (limit.kind == RateLimit::Kind::Window)
+            {
+                std::cout << "A windowed handler takes a batch of payloads; use addWindowed instead." << std::endl;
+                return 0;
+            }
+            EventHandler<Args2...> handler(std::move(f));
+            handler.m_gate = std::make_shared<RateGate<Args2...>>(this, limit);
+            return add(handler);
+        }
+
+        // Add a handler that's handed the calls of each interval together, as a contiguous array of payloads and its length, on
+        // the Event's rate timer thread. An interval only starts with the first call after the previous batch, so an idle Event
+        // doesn't deliver empty batches. Returns the handler's id.
+        template <typename F> size_t addWindowed(std::chrono::nanoseconds interval, F f)
+        {
+            EventHandler<Args2...> handler([](const Args2&...) {});
+            handler.m_gate = std::make_shared<RateGate<Args2...>>(this, RateLimit::window(interval));
+            handler.m_gate->windowFunc = std::move(f);
+            return add(handler);
+        }
+
+        // Remove an EventHandler from the Event by its id.
+        void remove(const EventHandler<Args2...>& handler)
+        {
+            remove_id(handler.id());
+        }
+
+        // Remove all EventHandlers in the input vector from the Event by their ids.
+        void remove(const std::vector<EventHandler<Args2...>>& handlers)
+        {
+            std::vector<size_t> handlerIds; handlerIds.reserve(handlers.size());
+            for (size_t i = 0; i < handlers.size(); ++i)
+            {
+                handlerIds.push_back(handlers[i].id());
+            }
+            remove_id(handlerIds);
+        }
+
+        // Remove an EventHandler from the Event by its id.
+        void remove_id(const size_t& handlerId)
+        {
+            remove_id(std::vector<size_t>(1, handlerId));
+        }
+
+        // Remove all EventHandlers in the input argument list from the Event by their ids. Each id is looked up in constant time,
+        // and the remaining handlers are then compacted (keeping their order) into the new snapshot in a single pass.
+        void remove_id(const std::vector<size_t>& handlerIds)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+
+            size_t removed = 0;
+            for (size_t i = 0; i < handlerIds.size(); ++i)
+            {
+                Slot* slot = findSlot(handlerIds[i]);
+                if (slot == nullptr)
+                {
+                    std::cout << "Handler id " << handlerIds[i] << " is stale or does not belong to this Event; unable to remove it." << std::endl;
+                    continue;
+                }
+                slot->index = NoIndex;
+                m_freeSlots.push_back(handlerIds[i] & SlotMask);
+                ++removed;
+            }
+
+            if (removed == 0)
+            {
+                return;
+            }
+
+            const HandlerSnapshot* current = m_snapshot.load();
+            publish(compact(current->handlers), compact(current->batchHandlers));
+        }
+
+        // Sequentially/synchronously call each EventHandler in this Event. The arguments are handed to every handler by reference,
+        // without being copied along the way.
+        void call(const Args2&... params)
+        {
+            m_published.add(1);
+            callHandlers(params...);
+        }
+
+        // Call each EventHandler in this Event once for every set of arguments in a batch. The handler snapshot is taken only once
+        // for the whole batch, and the loop is handler-major: each handler runs over the entire batch before the next one starts,
+        // so its code and captured state stay hot in cache. Note that this means a handler sees every payload of the batch before
+        // the following handler sees the first one, whereas calling the Event per payload interleaves them.
+        void callBatch(const std::tuple<Args2...>* payloads, size_t count)
+        {
+            m_published.add(count);
+            if (count > 0)
+            {
+                std::apply([this](const Args2&... params) { retainSticky(params...); }, payloads[count - 1]);
+            }
+            ReadGuard guard(*this);
+            for (const auto& handler : guard.handlers())
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    std::apply(handler, payloads[i]);
+                }
+            }
+
+            if (guard.batchHandlers().empty())
+            {
+                return;
+            }
+            if constexpr (std::is_same_v<Payload, std::tuple<Args2...>>)
+            {
+                callBatchImpl(guard.batchHandlers(), payloads, count);
+            }
+            else
+            {
+                std::vector<Payload> batch; batch.reserve(count);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    batch.push_back(std::get<0>(payloads[i]));
+                }
+                callBatchImpl(guard.batchHandlers(), batch.data(), batch.size());
+            }
+        }
+
+        // Allows one to run this Event in multiple threads. The Event is called on the shared worker pool, and the returned
+        // future becomes ready once every handler has run (or holds the exception one of them threw).
+        // The arguments are copied exactly once, into a buffer shared with the task, since the caller doesn't wait for the handlers to run.
+        std::future<void> callAsyncBlocking(const Args2&... params)
+        {
+            m_published.add(1);
+            // Like dispatch, every policy but Block rejects the call when the Event is at capacity; the future is then invalid.
+            if (!reserveAsync())
+            {
+                if (m_queuePolicy.load(std::memory_order_relaxed) != QueuePolicy::Block)
+                {
+                    dropAsync();
+                    return std::future<void>();
+                }
+                waitForAsyncCapacity();
+            }
+
+            std::shared_ptr<std::promise<void>> promise = std::make_shared<std::promise<void>>();
+            std::future<void> future = promise->get_future();
+            std::shared_ptr<const std::tuple<Args2...>> args = std::make_shared<const std::tuple<Args2...>>(params...);
+            m_container->submitTask([this, promise, args]()
+            {
+                std::exception_ptr error;
+                try
+                {
+                    std::apply([this](const Args2&... params) { callHandlers(params...); }, *args);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                // Uncount the call before fulfilling the promise, which may let the caller destroy the Event.
+                m_asyncPending.fetch_sub(1);
+                if (error)
+                {
+                    promise->set_exception(error);
+                }
+                else
+                {
+                    promise->set_value();
+                }
+            });
+            return future;
+        }
+
+        // Run the EventHandlers subscribed to this Event concurrently on the shared worker pool, and wait for all of them to finish.
+        // Since the caller waits, every handler reads the caller's arguments in place; none of them gets a copy of its own.
+        void callAsync(const Args2&... params)
+        {
+            m_published.add(1);
+            retainSticky(params...);
+            ReadGuard guard(*this);
+            callAsyncImpl(guard.handlers(), params...);
+            callBatchSingle(guard.batchHandlers(), params...);
+        }
+
+        // Run the EventHandlers subscribed to this Event concurrently on the shared worker pool without waiting for them. The
+        // arguments are copied once, into state shared by the submitted tasks, and the returned Completion becomes ready once every
+        // handler (and the batch handlers, which run together in a task of their own) has finished. The handler snapshot stays
+        // registered as read until then, so handlers unsubscribed in the meantime are still safe to run.
+        Completion dispatch(const Args2&... params)
+        {
+            return dispatchWithin(std::chrono::nanoseconds(m_deadline.load(std::memory_order_relaxed)),
+                m_overrunPolicy.load(std::memory_order_relaxed), params...);
+        }
+
+        // Like dispatch, but the watchdog checks on the handlers once the given budget has elapsed, and applies the policy to
+        // those still running (or still waiting to run) then. A budget of zero sets no deadline. The returned Completion doubles
+        // as the dispatch's cancellation token.
+        Completion dispatchWithin(std::chrono::nanoseconds budget, OverrunPolicy policy, const Args2&... params)
+        {
+            m_published.add(1);
+            // Tasks already handed to the pool can't be recalled, so every policy but Block rejects the new call.
+            if (!reserveAsync())
+            {
+                if (m_queuePolicy.load(std::memory_order_relaxed) != QueuePolicy::Block)
+                {
+                    dropAsync();
+                    return Completion();
+                }
+                waitForAsyncCapacity();
+            }
+
+            retainSticky(params...);
+            size_t parity = m_snapshot.enter();
+            const HandlerSnapshot* snapshot = m_snapshot.load();
+
+            // The snapshot may be reclaimed as soon as the last task finishes, so don't look at it once tasks are submitted.
+            size_t handlerCount = snapshot->handlers.size();
+            bool batching = !snapshot->batchHandlers.empty();
+            size_t tasks = handlerCount + (batching ? 1 : 0);
+            if (tasks == 0)
+            {
+                m_asyncPending.fetch_sub(1);
+                m_snapshot.leave(parity);
+                return Completion();
+            }
+
+            AsyncTask* task = new AsyncTask(*this, parity, snapshot, tasks, params...);
+            Completion completion = task->completion;
+            if (budget.count() > 0)
+            {
+                task->watch(budget, policy);
+            }
+            for (size_t i = 0; i < handlerCount; ++i)
+            {
+                // Handler i's task hasn't run yet, so the snapshot is still alive here. Handlers with a caller affinity run
+                // straight away, on this thread.
+                auto run = [task, i] { task->run(i, [task, i] { std::apply(task->snapshot->handlers[i], task->args); }); };
+                if (!submitTo(executorOf(snapshot->handlers[i]), run))
+                {
+                    run();
+                }
+            }
+            if (batching)
+            {
+                m_container->submitTask([task, handlerCount] { task->run(handlerCount, [task]
+                {
+                    std::apply([task](const Args2&... params) { task->event.callBatchSingle(task->snapshot->batchHandlers, params...); }, task->args);
+                }); });
+            }
+            return completion;
+        }
+
+        // Like dispatch, but calls made with the same key are delivered one at a time, in the order they were made, while calls with
+        // different keys are delivered in parallel on the shared worker pool. Each call runs every handler sequentially (as call()
+        // does), and the returned Completion becomes ready once it has. Keys are spread over a fixed number of lanes, each drained
+        // by at most one pool task at a time; keys sharing a lane are serialized with one another too, which costs parallelism but
+        // never ordering.
+        Completion dispatchOrdered(size_t key, const Args2&... params)
+        {
+            m_published.add(1);
+            OrderedLane* lanes = m_orderedLanes.load(std::memory_order_acquire);
+            if (lanes == nullptr)
+            {
+                lanes = createOrderedLanes();
+            }
+
+            // Fibonacci hashing, so that keys that are multiples of the lane count still spread over every lane.
+            OrderedLane& lane = lanes[(key * 0x9E3779B97F4A7C15ull) >> (64 - OrderedLaneBits)];
+
+            // At capacity, DropOldest evicts the oldest call still queued in the lane, and Coalesce replaces the arguments of the
+            // latest queued call with the same key (or, if there is none, lets the call in over capacity, so that the calls held
+            // back are bounded by the number of keys).
+            QueuePolicy policy = m_queuePolicy.load(std::memory_order_relaxed);
+            bool reserved = reserveAsync();
+            if (!reserved && policy != QueuePolicy::DropOldest && policy != QueuePolicy::Coalesce)
+            {
+                if (policy != QueuePolicy::Block)
+                {
+                    dropAsync();
+                    return Completion();
+                }
+                waitForAsyncCapacity();
+                reserved = true;
+            }
+
+            Completion completion;
+            std::optional<OrderedCall> evicted;
+            bool schedule;
+            {
+                std::lock_guard<std::mutex> lock(lane.lock);
+                if (!reserved && policy == QueuePolicy::DropOldest)
+                {
+                    if (lane.calls.empty())
+                    {
+                        dropAsync();
+                        return Completion();
+                    }
+                    evicted.emplace(std::move(lane.calls.front()));
+                    lane.calls.pop_front();
+                }
+                else if (!reserved)
+                {
+                    auto queued = std::find_if(lane.calls.rbegin(), lane.calls.rend(), [key](const OrderedCall& call) { return call.key == key; });
+                    if (queued != lane.calls.rend())
+                    {
+                        queued->args = std::tuple<Args2...>(params...);
+                        m_asyncPending.fetch_sub(1);
+                        m_coalesced.fetch_add(1, std::memory_order_relaxed);
+                        return queued->completion;
+                    }
+                }
+
+                completion = Completion(m_container, 1);
+                lane.calls.push_back(OrderedCall{ key, std::tuple<Args2...>(params...), completion });
+                schedule = !lane.scheduled;
+                lane.scheduled = true;
+            }
+            if (evicted)
+            {
+                dropAsync();
+                evicted->completion.complete();
+            }
+            if (schedule)
+            {
+                m_orderedRunners.fetch_add(1);
+                m_container->submitTask([this, &lane] { runOrderedLane(lane); });
+            }
+            return completion;
+        }
+
+        // Queue up a call to this Event's handlers instead of running them on the calling thread. The arguments are copied into a
+        // lock-free queue (created the first time the Event is posted to), and the handlers run later, on whichever thread drains
+        // the queue: a runner tick phase, the container's dispatcher thread, or an explicit drainPosted() call. If the queue is
+        // full, the Event's QueuePolicy applies (see setQueuePolicy); returns false if the call ends up not being queued.
+        // If the Event conflates its posted calls (see setConflation), the call instead replaces any undelivered call with the
+        // same conflation key, and posting always succeeds.
+        bool post(Args2... params)
+        {
+            m_published.add(1);
+            retainSticky(params...);
+            if (m_conflating.load(std::memory_order_acquire))
+            {
+                return postConflated(params...);
+            }
+
+            PostQueue* queue = m_postQueue.load(std::memory_order_acquire);
+            if (queue == nullptr)
+            {
+                queue = createPostQueue();
+            }
+
+            if (!queue->push(std::move(params)...) && !postOverflow(*queue, params...))
+            {
+                return false;
+            }
+            m_container->notifyPosted();
+            return true;
+        }
+
+        // Run the handlers (sequentially, on the calling thread) for the calls posted to this Event so far, oldest first. Calls
+        // posted while the queue is being drained are left for the next drain. Batch handlers are then called once with the
+        // payloads of every call that was drained. Only one thread drains a queue at a time; if another thread is already
+        // draining it, this returns straight away. Returns the number of posted calls dispatched.
+        size_t drainPosted()
+        {
+            if (!m_postRegistered.load(std::memory_order_acquire) || m_draining.test_and_set(std::memory_order_acquire))
+            {
+                return 0;
+            }
+
+            return drainHeld();
+        }
+
+        // Turn conflation of posted calls on or off. While it is on, posting to the Event replaces the undelivered call that has
+        // the same conflation key, if there is one, so the handlers only ever see the latest call per key and the number of
+        // queued calls is bounded by the number of keys. The key is computed from the call's arguments by keyOf (e.g. to
+        // conflate per device id); without a keyOf, every call shares the same key and only the latest one is kept.
+        // Calls that were already queued before conflation was turned on are still delivered in full.
+        void setConflation(bool enabled, std::function<size_t(const Args2&...)> keyOf = nullptr)
+        {
+            std::lock_guard<std::mutex> lock(m_conflationLock);
+            m_conflationKey = std::move(keyOf);
+            m_conflating.store(enabled, std::memory_order_release);
+        }
+
+        // Bound the Event's queued and asynchronous calls, and choose what happens to new ones once it's at capacity. capacity
+        // limits both the calls waiting in the post queue (it sizes the queue, so it only applies if set before the first post;
+        // until then the queue holds PostQueueCapacity calls) and the calls made with dispatch, dispatchOrdered or
+        // callAsyncBlocking that haven't been delivered yet (unbounded until set; 0 lifts the limit). Calls already handed to the
+        // worker pool can't be recalled, so for dispatch and callAsyncBlocking DropOldest and Coalesce act like DropNewest.
+        // Coalescing a posted call uses the conflation key (see setConflation). Blocking a post from the thread that drains the
+        // queue, or evicting a call for it, would never end, so with Block and DropOldest such a post is rejected instead. With
+        // Block, a post made while draining another Event drains this Event's queue inline to make room, and is rejected if
+        // that queue is already being drained.
+        void setQueuePolicy(size_t capacity, QueuePolicy policy)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            if (capacity != 0)
+            {
+                if (m_postQueue.load() != nullptr)
+                {
+                    std::cout << "The post queue of this Event already exists; its capacity stays at " << m_postQueue.load()->capacity() << "." << std::endl;
+                }
+                m_postCapacity = capacity;
+            }
+            m_asyncCapacity.store(capacity, std::memory_order_relaxed);
+            m_queuePolicy.store(policy, std::memory_order_relaxed);
+        }
+
+        // Turn stickiness on or off. A sticky Event retains the arguments of its latest call (or post, or the last payload of a
+        // callBatch), and replays them to every handler subscribed afterwards, right when it's subscribed and on the subscribing
+        // thread, so a plugin loaded after the Event last fired starts out with the current state. Calls retain their arguments
+        // before they take their handler snapshot, so a handler subscribed while the Event is being called never misses that
+        // call, but it may see it twice: once replayed by the subscription, and once delivered by the call, in either order.
+        // Handlers of sticky Events should therefore treat a call as the latest state rather than as something that happened
+        // once. Turning stickiness off forgets the retained arguments.
+        void setSticky(bool enabled)
+        {
+            m_sticky.store(enabled, std::memory_order_release);
+            if (!enabled)
+            {
+                m_stickyPayload.clear();
+            }
+        }
+
+        // Current overload counters, and the number of calls waiting to be delivered.
+        QueueStats queueStats() const
+        {
+            QueueStats stats;
+            stats.overflows = m_overflows.load(std::memory_order_relaxed);
+            stats.dropped = m_dropped.load(std::memory_order_relaxed);
+            stats.coalesced = m_coalesced.load(std::memory_order_relaxed);
+            stats.blocked = m_blocked.load(std::memory_order_relaxed);
+            stats.pending = m_asyncPending.load(std::memory_order_relaxed);
+            if (PostQueue* queue = m_postQueue.load(std::memory_order_acquire))
+            {
+                stats.pending += queue->size();
+            }
+            return stats;
+        }
+
+        // Publish and handler invocation counts, queue depth, and the latency histogram of every subscribed handler. Recording
+        // them only costs a few relaxed atomic increments on thread-local stripes, so they are always on; this adds the stripes up.
+        EventMetrics metrics() const
+        {
+            EventMetrics metrics;
+            metrics.name = m_name;
+            metrics.published = m_published.read();
+            metrics.queueDepth = queueStats().pending;
+
+            ReadGuard guard(*this);
+            metrics.handlers.reserve(guard.handlers().size());
+            for (const auto& handler : guard.handlers())
+            {
+                HandlerMetrics handlerMetrics;
+                handlerMetrics.id = handler.m_handlerId;
+                if (handler.m_owner != nullptr)
+                {
+                    handlerMetrics.plugin = handler.m_owner;
+                }
+                if (handler.m_recorder != nullptr)
+                {
+                    handler.m_recorder->read(handlerMetrics);
+                }
+                metrics.invocations += handlerMetrics.invocations;
+                metrics.handlers.push_back(std::move(handlerMetrics));
+            }
+            return metrics;
+        }
+
+        // Returns a copy of the Event's std::vector of EventHandlers. 
+        std::vector<EventHandler<Args2...>> getHandlersCopy() const
+        {
+            ReadGuard guard(*this);
+            return guard.handlers();
+        }
+
+        // Returns a copy of the Event's std::vector of EventBatchHandlers.
+        std::vector<EventBatchHandler<Args2...>> getBatchHandlersCopy() const
+        {
+            ReadGuard guard(*this);
+            return guard.batchHandlers();
+        }
+
+        // Flag that stays set until the Event is destroyed, shared with the EventRefs resolved to it so that they can tell.
+        std::shared_ptr<const std::atomic<bool>> liveness() const
+        {
+            return m_alive;
+        }
+
+        // Returns true if no thread is currently dispatching this Event's handlers.
+        bool isExecutionComplete() const
+        {
+            return m_snapshot.idle() && m_orderedRunners.load() == 0 && m_asyncPending.load() == 0;
         }
 
         // Copy assignment operator.
         Event<Args2...>& operator=(const Event<Args2...>& src)
         {
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-            std::lock_guard<std::recursive_mutex> lock2(src.m_handlersLocker);
+            if (&src == this) return *this;
+            std::vector<EventHandler<Args2...>> handlers = src.getHandlersCopy();
+            std::vector<EventBatchHandler<Args2...>> batchHandlers = src.getBatchHandlersCopy();
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            rebuildSlots(handlers, batchHandlers);
+            publish(std::move(handlers), std::move(batchHandlers));
+
+            return *this;
+        }
+
+        // Move assignment operator.
+        Event<Args2...>& operator=(Event<Args2...>&& src)
+        {
+            if (&src == this) return *this;
+            std::vector<EventHandler<Args2...>> handlers = src.getHandlersCopy();
+            std::vector<EventBatchHandler<Args2...>> batchHandlers = src.getBatchHandlersCopy();
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            rebuildSlots(handlers, batchHandlers);
+            publish(std::move(handlers), std::move(batchHandlers));
+
+            return *this;
+        }
+
+    private:
+        typedef MpscRingBuffer<std::tuple<Args2...>> PostQueue;
+        // Number of posted calls an Event's queue can hold before post() starts failing.
+        static constexpr size_t PostQueueCapacity = 1024;
+
+        // A call made with dispatchOrdered, waiting in its lane.
+        struct OrderedCall
+        {
+            size_t key;
+            std::tuple<Args2...> args;
+            Completion completion;
+        };
+
+        // FIFO of the ordered calls whose keys map to the lane. scheduled is set while a pool task is delivering them.
+        struct OrderedLane
+        {
+            std::mutex lock;
+            std::deque<OrderedCall> calls;
+            bool scheduled = false;
+        };
+
+        // Ordered calls are spread over 2^OrderedLaneBits lanes.
+        static constexpr size_t OrderedLaneBits = 6;
+        // Number of calls a lane delivers before handing its worker back to the pool, so a busy key can't monopolize a worker.
+        static constexpr size_t OrderedRunLimit = 32;
+
+        // A conflated posted call, along with the conflation key it was filed under.
+        struct ConflatedCall
+        {
+            size_t key;
+            std::tuple<Args2...> args;
+        };
+
+        // Serializes subscription/unsubscription (and the creation of the post queue); never taken on the dispatch path.
+        std::mutex m_writeLock;
+        // Cleared when the Event is destroyed (see liveness).
+        std::shared_ptr<std::atomic<bool>> m_alive = std::make_shared<std::atomic<bool>>(true);
+        // The currently-published handler snapshot, along with the readers and the retired snapshots.
+        EpochSnapshot<HandlerSnapshot> m_snapshot;
+        // Queue of posted calls, created on the first post(), and the flag that keeps it down to a single consumer.
+        std::atomic<PostQueue*> m_postQueue = nullptr;
+        std::atomic_flag m_draining = ATOMIC_FLAG_INIT;
+        // Set once the Event has been registered with the container's posted queues (on the first post of either kind).
+        std::atomic<bool> m_postRegistered = false;
+        // Conflation state: whether posted calls are conflated, how their keys are computed, the latest undelivered call per
+        // key, and the calls being delivered by the current drain (kept around so that its memory gets reused).
+        std::atomic<bool> m_conflating = false;
+        std::mutex m_conflationLock;
+        std::function<size_t(const Args2&...)> m_conflationKey;
+        std::vector<ConflatedCall> m_conflated;
+        std::vector<ConflatedCall> m_drainedConflated;
+        // Lanes of ordered calls (see dispatchOrdered), created on the first one, and the number of pool tasks currently scheduled
+        // to deliver them.
+        std::atomic<OrderedLane*> m_orderedLanes = nullptr;
+        std::atomic<size_t> m_orderedRunners = 0;
+        // Back-pressure (see setQueuePolicy): the capacity the post queue gets when it's created, the limit on undelivered
+        // asynchronous calls (0 for none) and how many there are, the policy, and the overload counters.
+        size_t m_postCapacity = PostQueueCapacity;
+        std::atomic<size_t> m_asyncCapacity = 0;
+        std::atomic<size_t> m_asyncPending = 0;
+        std::atomic<QueuePolicy> m_queuePolicy = QueuePolicy::DropNewest;
+        std::atomic<size_t> m_overflows = 0;
+        std::atomic<size_t> m_dropped = 0;
+        std::atomic<size_t> m_coalesced = 0;
+        std::atomic<size_t> m_blocked = 0;
+        // The Event's name, and the deadline given to its dispatches (see setDeadline), in nanoseconds.
+        std::string m_name;
+        std::atomic<int64_t> m_deadline = 0;
+        std::atomic<OverrunPolicy> m_overrunPolicy = OverrunPolicy::Report;
+        // Calls made to the Event, counted per thread stripe (see metrics).
+        PublishCounter m_published;
+
+        // Where the handlers subscribed without an affinity run when the Event is called asynchronously (see setAffinity).
+        std::atomic<size_t> m_defaultExecutor = EventHandler<Args2...>::PoolExecutor;
+
+        // How long the rate timer's thread waits for more work before exiting.
+        static constexpr std::chrono::seconds RateTimerLinger = std::chrono::seconds(1);
+
+        // Held-back calls of the debounced and windowed handlers, ordered by when they are due, and the state of the thread
+        // delivering them (see runRateTimer).
+        struct RateTimer
+        {
+            std::mutex lock;
+            std::condition_variable condition;
+            std::multimap<std::chrono::steady_clock::time_point, std::shared_ptr<RateGate<Args2...>>> due;
+            bool running = false;
+            bool stop = false;
+        };
+        RateTimer m_rateTimer;
+
+        // Whether the Event is sticky, and the arguments of its latest call (see setSticky).
+        std::atomic<bool> m_sticky = false;
+        StickySlot<std::conjunction_v<std::is_trivially_copyable<Args2>..., std::is_default_constructible<Args2>...>, Args2...> m_stickyPayload;
+        // The Event whose posted calls the current thread is draining, if any.
+        static inline thread_local const void* t_draining = nullptr;
+        // Payloads collected during a drain for the batch handlers. Only accessed by the thread holding m_draining, and kept
+        // around between drains so that its memory gets reused.
+        std::vector<Payload> m_drainedPayloads;
+        // Generational slot map from handler ids to positions in the handler list, plus the slots that are free for reuse.
+        // Only accessed with m_writeLock held.
+        std::vector<Slot> m_slots;
+        std::vector<size_t> m_freeSlots;
+        static inline std::atomic<size_t> m_generationCounter = 0;
+
+        // Create the post queue and register it with the container, which drains it along with the queues of all other Events.
+        PostQueue* createPostQueue()
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            PostQueue* queue = m_postQueue.load();
+            if (queue == nullptr)
+            {
+                queue = new PostQueue(m_postCapacity);
+                m_postQueue.store(queue, std::memory_order_release);
+                registerPosted();
+            }
+            return queue;
+        }
+
+        // Register the Event with the container the first time it is posted to. Must be called with m_writeLock held.
+        void registerPosted()
+        {
+            if (!m_postRegistered.load())
+            {
+                m_container->addPostedQueue(this, [this]() { return drainPosted(); });
+                m_postRegistered.store(true, std::memory_order_release);
+            }
+        }
+
+        // Helper function for post(Args... params) when the Event conflates its posted calls.
+        bool postConflated(Args2&... params)
+        {
+            if (!m_postRegistered.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(m_writeLock);
+                registerPosted();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_conflationLock);
+                size_t key = m_conflationKey ? m_conflationKey(params...) : 0;
+                auto it = std::find_if(m_conflated.begin(), m_conflated.end(), [key](const ConflatedCall& call) { return call.key == key; });
+                if (it != m_conflated.end())
+                {
+                    it->args = std::tuple<Args2...>(std::move(params)...);
+                    m_coalesced.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    m_conflated.push_back(ConflatedCall{ key, std::tuple<Args2...>(std::move(params)...) });
+                }
+            }
+            m_container->notifyPosted();
+            return true;
+        }
+
+        // Give a handler (or batch handler) a slot (reusing a free one if possible) and a fresh id, and add it to its list. Handlers
+        // go after the last handler whose priority isn't higher than theirs (shifting the handlers behind them, whose slots are
+        // updated accordingly); batch handlers are simply appended. Must be called with m_writeLock held.
+        template <typename Handler> size_t attach(std::vector<Handler>& handlers, Handler handler)
+        {
+            size_t position = handlers.size();
+            if constexpr (std::is_same_v<Handler, EventHandler<Args2...>>)
+            {
+                position = std::upper_bound(handlers.begin(), handlers.end(), handler.priority(),
+                    [](int priority, const Handler& other) { return priority < other.priority(); }) - handlers.begin();
+            }
+
+            size_t slotIndex;
+            if (!m_freeSlots.empty())
+            {
+                slotIndex = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else
+            {
+                slotIndex = m_slots.size();
+                m_slots.push_back(Slot{ 0, NoIndex });
+            }
+
+            if constexpr (std::is_same_v<Handler, EventHandler<Args2...>>)
+            {
+                if (handler.m_owner == nullptr)
+                {
+                    handler.m_owner = m_container->getCurrentPlugin();
+                }
+                if (handler.m_recorder == nullptr)
+                {
+                    handler.m_recorder = std::make_shared<HandlerRecorder>();
+                }
+            }
+
+            Slot& slot = m_slots[slotIndex];
+            slot.generation = ++m_generationCounter;
+            slot.index = position;
+            handler.m_handlerId = (slot.generation << SlotBits) | slotIndex;
+            size_t id = handler.m_handlerId;
+            handlers.insert(handlers.begin() + position, std::move(handler));
+            for (size_t i = position + 1; i < handlers.size(); ++i)
+            {
+                m_slots[handlers[i].id() & SlotMask].index = i;
+            }
+            return id;
+        }
+
+        // Return the slot of a live handler id, or nullptr if the id is stale or was never handed out by this Event.
+        // Must be called with m_writeLock held.
+        Slot* findSlot(size_t handlerId)
+        {
+            size_t slotIndex = handlerId & SlotMask;
+            if (slotIndex >= m_slots.size())
+            {
+                return nullptr;
+            }
+
+            Slot& slot = m_slots[slotIndex];
+            if (slot.index == NoIndex || (slot.generation << SlotBits) != (handlerId & ~SlotMask))
+            {
+                return nullptr;
+            }
+            return &slot;
+        }
+
+        // Copy the handlers that are still live (i.e. whose slots weren't freed) into a new list, keeping their order, and update
+        // their slots to their new positions. Must be called with m_writeLock held.
+        template <typename Handler> std::vector<Handler> compact(const std::vector<Handler>& current)
+        {
+            std::vector<Handler> handlers; handlers.reserve(current.size());
+            for (const auto& handler : current)
+            {
+                Slot& slot = m_slots[handler.id() & SlotMask];
+                if (slot.index != NoIndex)
+                {
+                    slot.index = handlers.size();
+                    handlers.push_back(handler);
+                }
+            }
+            return handlers;
+        }
+
+        // Recreate the slot map for handler lists copied from another Event, keeping the ids the handlers already had.
+        // Must be called with m_writeLock held (or from a constructor).
+        void rebuildSlots(const std::vector<EventHandler<Args2...>>& handlers, const std::vector<EventBatchHandler<Args2...>>& batchHandlers)
+        {
+            m_slots.clear();
+            m_freeSlots.clear();
+            addSlots(handlers);
+            addSlots(batchHandlers);
+            for (size_t i = 0; i < m_slots.size(); ++i)
+            {
+                if (m_slots[i].index == NoIndex)
+                {
+                    m_freeSlots.push_back(i);
+                }
+            }
+        }
+
+        // Helper function for rebuildSlots. Records the slot of every handler in a list.
+        template <typename Handler> void addSlots(const std::vector<Handler>& handlers)
+        {
+            for (size_t i = 0; i < handlers.size(); ++i)
+            {
+                size_t slotIndex = handlers[i].id() & SlotMask;
+                if (slotIndex >= m_slots.size())
+                {
+                    m_slots.resize(slotIndex + 1, Slot{ 0, NoIndex });
+                }
+                m_slots[slotIndex] = Slot{ handlers[i].id() >> SlotBits, i };
+            }
+        }
+
+        // Publish a new snapshot with the given handlers (keeping the current batch handlers) and retire the previous one.
+        // Must be called with m_writeLock held.
+        void publish(std::vector<EventHandler<Args2...>> handlers)
+        {
+            publish(std::move(handlers), m_snapshot.load()->batchHandlers);
+        }
+
+        // Publish a new handler snapshot and retire the previous one. Must be called with m_writeLock held.
+        void publish(std::vector<EventHandler<Args2...>> handlers, std::vector<EventBatchHandler<Args2...>> batchHandlers)
+        {
+            HandlerSnapshot* snapshot = new HandlerSnapshot;
+            snapshot->handlers = std::move(handlers);
+            snapshot->batchHandlers = std::move(batchHandlers);
+            m_snapshot.publish(snapshot);
+        }
+
+        // Run every handler (and batch handler) on the calling thread. Shared by call() and the pool tasks that deliver the calls
+        // made with callAsyncBlocking and dispatchOrdered, which are counted as published when they are made.
+        void callHandlers(const Args2&... params)
+        {
+            retainSticky(params...);
+            ReadGuard guard(*this);
+            callImpl(guard.handlers(), params...);
+            callBatchSingle(guard.batchHandlers(), params...);
+        }
+
+        // Helper function for call(Args... params). Simply loops through all handles in the Event
+        // and calls them in the order that they are stored.
+        void callImpl(const std::vector<EventHandler<Args2...>>& handlers, const Args2&... params) const
+        {
+            //std::cout << "Num Handles: " << handlers.size() << std::endl;
+            for (const auto& handler : handlers)
+            {
+                handler(params...);
+            }
+        }
+
+        // Helper function for delivering a batch of payloads. Calls each batch handle once, in the order that they are stored.
+        void callBatchImpl(const std::vector<EventBatchHandler<Args2...>>& batchHandlers, const Payload* payloads, size_t count) const
+        {
+            for (const auto& handler : batchHandlers)
+            {
+                handler(payloads, count);
+            }
+        }
+
+        // Hand the arguments of a single call to the batch handlers, as a batch of one. For single-argument Events the argument is
+        // the payload itself, so it's passed without a copy.
+        void callBatchSingle(const std::vector<EventBatchHandler<Args2...>>& batchHandlers, const Args2&... params) const
+        {
+            if (batchHandlers.empty())
+            {
+                return;
+            }
+            if constexpr (std::is_same_v<Payload, std::tuple<Args2...>>)
+            {
+                Payload payload(params...);
+                callBatchImpl(batchHandlers, &payload, 1);
+            }
+            else
+            {
+                callBatchImpl(batchHandlers, std::addressof(params)..., 1);
+            }
+        }
+
+        // Convert the arguments of a posted call into the payload type handed to batch handlers.
+        static Payload toPayload(std::tuple<Args2...>&& args)
+        {
+            if constexpr (std::is_same_v<Payload, std::tuple<Args2...>>)
+            {
+                return std::move(args);
+            }
+            else
+            {
+                return std::get<0>(std::move(args));
+            }
+        }
+
+        // State shared by the pool tasks of a single callAsync. It lives on the caller's stack, so each submitted task only has to
+        // capture a reference to it and an index, which is small enough for std::function to store without allocating.
+        struct AsyncDispatch
+        {
+            AsyncDispatch(const std::vector<EventHandler<Args2...>>& _handlers, const Args2&... params)
+                : handlers(_handlers), args(params...), latch(_handlers.size())
+            {}
+
+            // Run a handler, wherever it's been sent. An exception is kept (the first one only) for the caller to rethrow once
+            // every handler is done, and the latch is counted down regardless, since the caller's stack frame holding the
+            // dispatch must outlive every task referring to it.
+            void run(size_t i)
+            {
+                try
+                {
+                    std::apply(handlers[i], args);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorLock);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                latch.countDown();
+            }
+
+            const std::vector<EventHandler<Args2...>>& handlers;
+            std::tuple<const Args2&...> args;
+            Latch latch;
+            std::mutex errorLock;
+            std::exception_ptr error;
+        };
+
+        // Decide whether a call goes through to a rate-limited handler right away. Debounced and windowed calls are held back in
+        // the handler's gate instead, and handed to the rate timer.
+        bool admit(const std::shared_ptr<RateGate<Args2...>>& gate, const Args2&... params)
+        {
+            typedef std::chrono::steady_clock Clock;
+            switch (gate->limit.kind)
+            {
+            case RateLimit::Kind::Throttle:
+            {
+                int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+                int64_t next = gate->nextDelivery.load(std::memory_order_relaxed);
+                return now >= next
+                    && gate->nextDelivery.compare_exchange_strong(next, now + gate->limit.interval.count(), std::memory_order_relaxed);
+            }
+            case RateLimit::Kind::Sample:
+                return (gate->calls.fetch_add(1, std::memory_order_relaxed) + 1) % gate->limit.every == 0;
+            case RateLimit::Kind::Debounce:
+            case RateLimit::Kind::Window:
+            {
+                Clock::time_point deadline;
+                {
+                    std::lock_guard<std::mutex> lock(gate->lock);
+                    if (gate->limit.kind == RateLimit::Kind::Debounce)
+                    {
+                        gate->latest.emplace(params...);
+                        gate->deadline = Clock::now() + gate->limit.interval;
+                    }
+                    else
+                    {
+                        gate->window.emplace_back(params...);
+                        if (!gate->armed)
+                        {
+                            gate->deadline = Clock::now() + gate->limit.interval;
+                        }
+                    }
+                    if (gate->armed)
+                    {
+                        return false;
+                    }
+                    gate->armed = true;
+                    deadline = gate->deadline;
+                }
+                scheduleRateFlush(gate, deadline);
+                return false;
+            }
+            }
+            return true;
+        }
+
+        // Queue a gate for the rate timer, starting the timer's thread if it isn't running.
+        void scheduleRateFlush(const std::shared_ptr<RateGate<Args2...>>& gate, std::chrono::steady_clock::time_point deadline)
+        {
+            std::lock_guard<std::mutex> lock(m_rateTimer.lock);
+            if (m_rateTimer.stop)
+            {
+                return;
+            }
+            m_rateTimer.due.emplace(deadline, gate);
+            if (m_rateTimer.running)
+            {
+                m_rateTimer.condition.notify_all();
+            }
+            else
+            {
+                m_rateTimer.running = true;
+                m_container->submitLongRunningTask([this] { runRateTimer(); });
+            }
+        }
+
+        // Body of the rate timer's thread: deliver the held-back calls of each gate when they are due. The thread exits once it has
+        // been idle for RateTimerLinger, and is started again by the next debounced or windowed call.
+        void runRateTimer()
+        {
+            std::unique_lock<std::mutex> lock(m_rateTimer.lock);
+            while (!m_rateTimer.stop)
+            {
+                if (m_rateTimer.due.empty())
+                {
+                    if (!m_rateTimer.condition.wait_for(lock, RateTimerLinger, [this] { return m_rateTimer.stop || !m_rateTimer.due.empty(); }))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                auto first = m_rateTimer.due.begin();
+                if (std::chrono::steady_clock::now() < first->first)
+                {
+                    m_rateTimer.condition.wait_until(lock, first->first);
+                    continue;
+                }
+                std::shared_ptr<RateGate<Args2...>> gate = std::move(first->second);
+                m_rateTimer.due.erase(first);
+
+                lock.unlock();
+                flushRate(gate);
+                lock.lock();
+            }
+            m_rateTimer.running = false;
+            m_rateTimer.condition.notify_all();
+        }
+
+        // Hand a gate's held-back calls to its handler, unless a debounced call arrived meanwhile and pushed the deadline back.
+        void flushRate(const std::shared_ptr<RateGate<Args2...>>& gate)
+        {
+            std::optional<std::tuple<Args2...>> latest;
+            std::vector<Payload> window;
+            {
+                std::lock_guard<std::mutex> lock(gate->lock);
+                if (std::chrono::steady_clock::now() < gate->deadline)
+                {
+                    std::lock_guard<std::mutex> timerLock(m_rateTimer.lock);
+                    m_rateTimer.due.emplace(gate->deadline, gate);
+                    return;
+                }
+                gate->armed = false;
+                latest.swap(gate->latest);
+                window.swap(gate->window);
+            }
+
+            // The handler may have been removed since its calls were held back, in which case they're dropped.
+            ReadGuard guard(*this);
+            for (const auto& handler : guard.handlers())
+            {
+                if (handler.m_gate != gate)
+                {
+                    continue;
+                }
+                try
+                {
+                    if (latest)
+                    {
+                        handler.timed([&] { std::apply(handler.m_handlerFunc, *latest); });
+                    }
+                    else if (!window.empty())
+                    {
+                        handler.timed([&] { gate->windowFunc(window.data(), window.size()); });
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::cout << "A rate-limited handler threw an exception: " << e.what() << std::endl;
+                }
+                return;
+            }
+        }
+
+        // Keep the arguments of a call if the Event is sticky. Done before the call takes its handler snapshot, so a handler
+        // subscribed concurrently either is in that snapshot or gets these arguments replayed.
+        void retainSticky(const Args2&... params)
+        {
+            if (m_sticky.load(std::memory_order_acquire))
+            {
+                m_stickyPayload.retain(params...);
+            }
+        }
+
+        // Hand the retained arguments of a sticky Event to a newly subscribed handler (regular or batch).
+        void replaySticky(size_t handlerId)
+        {
+            if (!m_sticky.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            m_stickyPayload.visit([this, handlerId](const std::tuple<Args2...>& last)
+            {
+                ReadGuard guard(*this);
+                for (const auto& handler : guard.handlers())
+                {
+                    if (handler.id() == handlerId)
+                    {
+                        std::apply(handler, last);
+                        return;
+                    }
+                }
+                for (const auto& handler : guard.batchHandlers())
+                {
+                    if (handler.id() == handlerId)
+                    {
+                        if constexpr (std::is_same_v<Payload, std::tuple<Args2...>>)
+                        {
+                            handler(&last, 1);
+                        }
+                        else
+                        {
+                            handler(&std::get<0>(last), 1);
+                        }
+                        return;
+                    }
+                }
+            });
+        }
+
+        void replaySticky(const std::vector<size_t>& handlerIds)
+        {
+            for (size_t handlerId : handlerIds)
+            {
+                replaySticky(handlerId);
+            }
+        }
+
+        // Body of drainPosted, for a thread that has already taken m_draining (which is released on the way out).
+        size_t drainHeld()
+        {
+            size_t drained = 0;
+            DrainScope scope(*this);
+            {
+                // A handler that throws only loses the call it was handed: the exception is reported (there's no caller to
+                // hand it to) and the drain carries on with the next call.
+                ReadGuard guard(*this);
+                bool batching = !guard.batchHandlers().empty();
+                auto deliver = [this, &guard, batching](std::tuple<Args2...>& args)
+                {
+                    try
+                    {
+                        std::apply([this, &guard](Args2&... params) { callImpl(guard.handlers(), params...); }, args);
+                    }
+                    catch (...)
+                    {
+                        reportDrainError(std::current_exception());
+                    }
+                    if (batching)
+                    {
+                        m_drainedPayloads.push_back(toPayload(std::move(args)));
+                    }
+                };
+
+                if (PostQueue* queue = m_postQueue.load(std::memory_order_acquire))
+                {
+                    size_t pending = queue->size();
+                    while (drained < pending && queue->consume(deliver))
+                    {
+                        ++drained;
+                    }
+                }
+
+                // Calls that were conflated are taken out all at once, so that posts made in the meantime start a fresh set.
+                {
+                    std::lock_guard<std::mutex> lock(m_conflationLock);
+                    std::swap(m_conflated, m_drainedConflated);
+                }
+                for (auto& conflated : m_drainedConflated)
+                {
+                    deliver(conflated.args);
+                }
+                drained += m_drainedConflated.size();
+                m_drainedConflated.clear();
+
+                if (!m_drainedPayloads.empty())
+                {
+                    try
+                    {
+                        callBatchImpl(guard.batchHandlers(), m_drainedPayloads.data(), m_drainedPayloads.size());
+                    }
+                    catch (...)
+                    {
+                        reportDrainError(std::current_exception());
+                    }
+                    m_drainedPayloads.clear();
+                }
+            }
+            return drained;
+        }
+
+        // Marks the calling thread as draining the Event for the duration of a drain, and releases the drain on the way out,
+        // however the drain ends.
+        struct DrainScope
+        {
+            explicit DrainScope(Event& _event)
+                : event(_event), outerDrain(t_draining)
+            {
+                t_draining = &event;
+            }
+
+            ~DrainScope()
+            {
+                t_draining = outerDrain;
+                event.m_draining.clear(std::memory_order_release);
+            }
+
+            Event& event;
+            const void* outerDrain;
+        };
+
+        void reportDrainError(std::exception_ptr error) const
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::exception& exception)
+            {
+                std::cout << "A handler of Event " << m_name << " threw an exception (" << exception.what() << ") on a posted call; unable to deliver it" << std::endl;
+            }
+            catch (...)
+            {
+                std::cout << "A handler of Event " << m_name << " threw an exception on a posted call; unable to deliver it" << std::endl;
+            }
+        }
+
+        // Apply the queue policy to a post that found the queue full. Returns whether the call got queued after all.
+        bool postOverflow(PostQueue& queue, Args2&... params)
+        {
+            m_overflows.fetch_add(1, std::memory_order_relaxed);
+            switch (m_queuePolicy.load(std::memory_order_relaxed))
+            {
+            case QueuePolicy::Block:
+                if (t_draining == this)
+                {
+                    break;
+                }
+                m_blocked.fetch_add(1, std::memory_order_relaxed);
+                while (!queue.push(std::move(params)...))
+                {
+                    if (t_draining == nullptr)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    // A handler of another Event posting here: the drain that would make room may be due to run on this very
+                    // thread once the handler returns, so drain the queue inline; if its drain is already taken (possibly
+                    // further up this thread's stack), waiting could never end, so the call is rejected.
+                    if (m_draining.test_and_set(std::memory_order_acquire))
+                    {
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    drainHeld();
+                }
+                return true;
+
+            case QueuePolicy::DropOldest:
+                // Evicting means consuming, so it needs the consumer's side of the queue; if a drain holds it, the drain is
+                // making room anyway. Unless this thread is the one draining (a handler posting to its own Event): the drain
+                // can't go on until the post returns, so the new call is dropped instead.
+                if (t_draining == this)
+                {
+                    break;
+                }
+                while (!queue.push(std::move(params)...))
+                {
+                    if (!m_draining.test_and_set(std::memory_order_acquire))
+                    {
+                        if (queue.consume([](std::tuple<Args2...>&) {}))
+                        {
+                            m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        m_draining.clear(std::memory_order_release);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                return true;
+
+            case QueuePolicy::Coalesce:
+                return postConflated(params...);
+
+            case QueuePolicy::DropNewest:
+                break;
+            }
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Count a new asynchronous call as pending. Returns false if that puts the Event over capacity; the call is counted
+        // regardless, and the caller applies the policy (calling dropAsync if the call doesn't go ahead).
+        bool reserveAsync()
+        {
+            size_t capacity = m_asyncCapacity.load(std::memory_order_relaxed);
+            size_t pending = m_asyncPending.fetch_add(1);
+            if (capacity == 0 || pending < capacity)
+            {
+                return true;
+            }
+            m_overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Wait until the pending asynchronous calls (the caller's included) fit within the capacity, running queued pool tasks
+        // in the meantime so that a pool thread waiting here doesn't hold up the calls it waits on.
+        void waitForAsyncCapacity()
+        {
+            m_blocked.fetch_add(1, std::memory_order_relaxed);
+            while (true)
+            {
+                size_t capacity = m_asyncCapacity.load(std::memory_order_relaxed);
+                if (capacity == 0 || m_asyncPending.load() <= capacity)
+                {
+                    return;
+                }
+                if (!m_container->runPendingTask())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // Uncount a pending asynchronous call that was rejected or evicted.
+        void dropAsync()
+        {
+            m_asyncPending.fetch_sub(1);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        OrderedLane* createOrderedLanes()
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            OrderedLane* lanes = m_orderedLanes.load();
+            if (lanes == nullptr)
+            {
+                lanes = new OrderedLane[size_t(1) << OrderedLaneBits];
+                m_orderedLanes.store(lanes, std::memory_order_release);
+            }
+            return lanes;
+        }
+
+        // Deliver a lane's calls in order, until it's empty or OrderedRunLimit calls have been delivered, in which case the rest
+        // are left to a fresh pool task. The task counts in m_orderedRunners until it returns, which keeps the Event alive.
+        void runOrderedLane(OrderedLane& lane)
+        {
+            for (size_t delivered = 0; ; ++delivered)
+            {
+                std::optional<OrderedCall> orderedCall;
+                {
+                    std::lock_guard<std::mutex> lock(lane.lock);
+                    if (lane.calls.empty())
+                    {
+                        lane.scheduled = false;
+                        break;
+                    }
+                    if (delivered == OrderedRunLimit)
+                    {
+                        m_container->submitTask([this, &lane] { runOrderedLane(lane); });
+                        return;
+                    }
+                    orderedCall.emplace(std::move(lane.calls.front()));
+                    lane.calls.pop_front();
+                }
+
+                std::exception_ptr error;
+                try
+                {
+                    std::apply([this](const Args2&... params) { callHandlers(params...); }, orderedCall->args);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                m_asyncPending.fetch_sub(1);
+                orderedCall->completion.complete(error);
+            }
+            m_orderedRunners.fetch_sub(1);
+        }
+
+        // State of a handler added with addOnce. id holds the handler's id once add() has returned, or OnceFired if the handler has
+        // already run by then, so that exactly one of the two threads removes it.
+        static constexpr size_t OnceFired = ~size_t(0);
+
+        template <typename Pred, typename F> struct OnceState
+        {
+            OnceState(Pred _pred, F _f)
+                : pred(std::move(_pred)), f(std::move(_f))
+            {}
+
+            Pred pred;
+            F f;
+            std::atomic<bool> fired = false;
+            std::atomic<size_t> id = 0;
+        };
+
+        // State shared by the pool tasks of a single dispatch. The caller doesn't wait for them, so it's allocated on the heap and
+        // deleted by the last task to finish, which also ends the read of the handler snapshot. Tasks capture a pointer to it and an
+        // index, which std::function stores without allocating.
+        struct AsyncTask
+        {
+            AsyncTask(Event<Args2...>& _event, size_t _parity, const HandlerSnapshot* _snapshot, size_t tasks, const Args2&... params)
+                : event(_event), parity(_parity), snapshot(_snapshot), args(params...), remaining(tasks), completion(m_container, tasks)
+            {}
+
+            // Run task index (handler index, or the batch handlers' task, which comes after the handlers) unless the dispatch has
+            // been cancelled, or the watchdog has detached the task before it started.
+            template <typename F> void run(size_t index, F&& f)
+            {
+                std::exception_ptr error;
+                bool detached = false;
+                if (states != nullptr)
+                {
+                    unsigned char queued = Queued;
+                    detached = !states[index].compare_exchange_strong(queued, Running);
+                }
+                if (!detached && !completion.isCancelled())
+                {
+                    Completion::Scope scope(completion);
+                    try
+                    {
+                        f();
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                if (states != nullptr && !detached)
+                {
+                    detached = states[index].exchange(Finished) == Detached;
+                }
+
+                // Completing may let the caller destroy the Event, so the snapshot read has to end first. A detached task has
+                // already been counted as complete by the watchdog.
+                Completion done = completion;
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (ticket != 0)
+                    {
+                        m_container->clearDeadline(ticket);
+                    }
+                    event.m_asyncPending.fetch_sub(1);
+                    event.m_snapshot.leave(parity);
+                    delete this;
+                }
+                if (!detached)
+                {
+                    done.complete(error);
+                }
+            }
+
+            // Have the watchdog check on the tasks once the budget has elapsed. Must be called before any task is submitted.
+            void watch(std::chrono::nanoseconds budget, OverrunPolicy policy)
+            {
+                size_t count = snapshot->handlers.size() + (snapshot->batchHandlers.empty() ? 0 : 1);
+                states.reset(new std::atomic<unsigned char>[count]);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    states[i].store(Queued, std::memory_order_relaxed);
+                }
+                ticket = m_container->watchDeadline(std::chrono::steady_clock::now() + budget, [this, budget, policy, count]
+                {
+                    overrun(budget, policy, count);
+                });
+            }
+
+            // Called on the watchdog's thread when the deadline passes. The task can't be deleted in the meantime, since the last
+            // task to finish clears the deadline first, which waits for this to return.
+            void overrun(std::chrono::nanoseconds budget, OverrunPolicy policy, size_t count)
+            {
+                if (policy != OverrunPolicy::Report)
+                {
+                    completion.cancel();
+                }
+                long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(budget).count();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    unsigned char state = states[i].load();
+                    if (state == Finished)
+                    {
+                        continue;
+                    }
+
+                    const char* owner = i < snapshot->handlers.size() ? snapshot->handlers[i].m_owner : nullptr;
+                    std::cout << "WATCHDOG: " << (i < snapshot->handlers.size() ? "handler " + std::to_string(snapshot->handlers[i].id()) : std::string("batch handlers"))
+                        << " of plugin " << (owner != nullptr ? owner : "<unknown>") << " on Event " << event.name()
+                        << (state == Running ? " is still running " : " hasn't started ") << milliseconds << " ms into its dispatch"
+                        << (policy == OverrunPolicy::Detach ? "; detaching it" : "") << std::endl;
+
+                    if (policy == OverrunPolicy::Detach && states[i].compare_exchange_strong(state, Detached))
+                    {
+                        completion.complete();
+                    }
+                }
+            }
+
+            // Per-task progress, only tracked when the dispatch has a deadline.
+            static constexpr unsigned char Queued = 0;
+            static constexpr unsigned char Running = 1;
+            static constexpr unsigned char Finished = 2;
+            static constexpr unsigned char Detached = 3;
+
+            Event<Args2...>& event;
+            size_t parity;
+            const HandlerSnapshot* snapshot;
+            const std::tuple<Args2...> args;
+            std::atomic<size_t> remaining;
+            Completion completion;
+            std::unique_ptr<std::atomic<unsigned char>[]> states;
+            size_t ticket = 0;
+        };
+
+        // Helper function for callAsync(Args... params). Submits every subscribed handle to the executor its affinity names (the
+        // worker pool shared by all EventStreams, by default), except for the handles with a caller affinity, which run on the
+        // calling thread right away, and the first handle bound for the pool, which the calling thread runs once everything else
+        // has been submitted. It then waits on a latch until all of them have finished.
+        void callAsyncImpl(const std::vector<EventHandler<Args2...>>& handlers, const Args2&... params)
+        {
+            if (handlers.empty())
+            {
+                return;
+            }
+
+            AsyncDispatch dispatch(handlers, params...);
+            size_t first = handlers.size();
+            for (size_t i = 0; i < handlers.size(); ++i)
+            {
+                size_t executor = executorOf(handlers[i]);
+                if (executor == EventHandler<Args2...>::PoolExecutor && first == handlers.size())
+                {
+                    first = i;
+                }
+                else if (!submitTo(executor, [&dispatch, i] { dispatch.run(i); }))
+                {
+                    dispatch.run(i);
+                }
+            }
+
+            if (first != handlers.size())
+            {
+                dispatch.run(first);
+            }
+            dispatch.latch.wait();
+            if (dispatch.error)
+            {
+                std::rethrow_exception(dispatch.error);
+            }
+        }
+
+        // The executor a handler runs on when the Event is called asynchronously.
+        size_t executorOf(const EventHandler<Args2...>& handler) const
+        {
+            return handler.m_executor == EventHandler<Args2...>::DefaultExecutor ? m_defaultExecutor.load(std::memory_order_relaxed) : handler.m_executor;
+        }
+
+        size_t toExecutor(const Affinity& affinity) const
+        {
+            switch (affinity.kind)
+            {
+            case Affinity::Kind::Pool:
+                return EventHandler<Args2...>::PoolExecutor;
+            case Affinity::Kind::Caller:
+                return EventHandler<Args2...>::CallerExecutor;
+            case Affinity::Kind::Executor:
+            {
+                size_t executor = m_container->getExecutor(affinity.executorName, affinity.core);
+                return executor == ~size_t(0) ? EventHandler<Args2...>::PoolExecutor : executor;
+            }
+            default:
+                return EventHandler<Args2...>::DefaultExecutor;
+            }
+        }
+
+        // Hand a task to an executor. Returns false if the task has to run on the calling thread instead: for a caller
+        // affinity, or when the calling thread is the executor itself (which would otherwise wait on its own queue).
+        template <typename F> bool submitTo(size_t executor, const F& task) const
+        {
+            if (executor == EventHandler<Args2...>::PoolExecutor)
+            {
+                m_container->submitTask(task);
+                return true;
+            }
+            if (executor == EventHandler<Args2...>::CallerExecutor || executor == m_container->currentExecutor())
+            {
+                return false;
+            }
+            m_container->submitToExecutor(executor, task);
+            return true;
+        }
+    };
+
+    // Look up the Event stored in the container under the given key. Returns nullptr if there is no such Event.
+    Event<Args...>* getEvent(const EventKey& eventName) const
+    {
+        return static_cast<Event<Args...>*>(m_container->getEvent(eventName));
+    }
+
+    // A wildcard subscription (see subscribePattern()). A copy of its handler, built by makeHandler for the name of the Event it
+    // goes to, is attached to every Event of this EventStream whose name matches the pattern; attached maps the key of each of
+    // those Events to the id of the copy subscribed to it.
+    struct PatternSubscription
+    {
+        std::string pattern;
+        int priority;
+        std::function<EventHandler<Args...>(const std::string&)> makeHandler;
+        std::map<EventKey::Hash, size_t> attached;
+    };
+
+    // Subscribe a wildcard subscription to one of the Events it matches. m_lock must be held.
+    void attachPattern(PatternSubscription& subscription, const std::string& topic)
+    {
+        if (Event<Args...>* event = getEvent(topic))
+        {
+            subscription.attached[EventKey(topic).hash()] = event->add(subscription.makeHandler(topic), subscription.priority);
+        }
+    }
+
+    // Wildcard subscriptions, the trie their patterns are matched through, and the names of the Events created through this
+    // EventStream (keyed like the container), which new patterns are matched against. All guarded by m_lock.
+    std::map<size_t, PatternSubscription> m_patternSubscriptions;
+    TopicTrie m_patterns;
+    std::map<EventKey::Hash, std::string> m_topics;
+    size_t m_nextPatternId = 1;
+
+public:
+    // Type of the payloads handed to batch handlers (see subscribeBatch()).
+    typedef typename PayloadType<Args...>::type Payload;
+
+    // EventRef is a handle to an Event that has already been looked up by name (see resolve()). Publishing through an EventRef
+    // skips the container's name lookup entirely, so no strings are copied, hashed or compared, which makes it the preferred way
+    // to call an Event from hot loops. An EventRef does not keep its Event alive: it becomes invalid (and calls made through it
+    // are rejected) once the last destroy() call for that Event has deleted it, even if an Event with the same name is created
+    // again later. A call racing that last destroy() is no safer than a call by name, so an EventRef is best resolved by the
+    // plugin that created the Event (or that otherwise holds a create() reference).
+    class EventRef
+    {
+    public:
+        EventRef() = default;
+
+        bool valid() const
+        {
+            return m_event != nullptr && m_alive->load(std::memory_order_acquire);
+        }
+
+        explicit operator bool() const
+        {
+            return valid();
+        }
+
+        const std::string& name() const
+        {
+            return m_name;
+        }
+
+    private:
+        friend class EventStream<Args...>;
+
+        EventRef(const std::string& eventName, Event<Args...>* event)
+            : m_name(eventName), m_event(event), m_alive(event->liveness())
+        {}
+
+        std::string m_name;
+        Event<Args...>* m_event = nullptr;
+        std::shared_ptr<const std::atomic<bool>> m_alive;
+    };
+
+    void requestDelete()
+    {
+        // Use the function signature of requestDelete() to obtain the EventStream's templated specialization type.
+        #ifdef _WIN32
+        std::string type = esType(__FUNCSIG__);
+        #elif __linux__
+        std::string type = esType(__PRETTY_FUNCTION__);
+        #endif
+
+        std::cout << "_______________EventStream<" << type << "> requestDelete has been called_______________" << std::endl;
+        
+        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        {
+            std::cout << "EventStream<" << type << "> count BEFORE: " << m_container->getEventStreamRefCount().at(type) << std::endl;
+        }
+        else
+        {
+            std::cout << "EventStream<" << type << "> count BEFORE: " << 0 << std::endl;
+        }
+
+        // If the EventStream type is not even present in the container, do nothing.
+        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        {
+            // If only one reference exists for the EventStream we wish to delete, then destruct that EventStream. Otherwise
+            // simply decrement its reference counter.
+            if (m_container->getEventStreamRefCount().at(type) > 1)
+            {
+                m_container->subtractEventStreamRefCount(type);
+            }
+            else
+            {
+                delete static_cast<EventStream<Args...>*>(m_container->getEventStreams().at(type));
+                m_container->eraseEventStream(type);
+                m_container->eraseEventStreamRefCount(type);
+            }
+        }
+
+        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        {
+            std::cout << "EventStream<" << type << "> count AFTER: " << m_container->getEventStreamRefCount().at(type) << std::endl;
+        }
+        else
+        {
+            std::cout << "EventStream<" << type << "> count AFTER: " << 0 << std::endl;
+        }
+    }
+
+    // Note that EventStream is a singleton. The size_t identifier is a hashed representation of the app's executable
+    // directory.
+    static EventStream* Instance(size_t identifier)
+    {
+        loadContainer(identifier);
+
+        // Use the function signature of Instance() to obtain the EventStream's templated specialization type.
+        #ifdef _WIN32
+        std::string type = esType(__FUNCSIG__);
+        #elif __linux__
+        std::string type = esType(__PRETTY_FUNCTION__);
+        #endif
+
+        // If the template specialization of EventStream we wish to create doesn't already exist, create a new instance of
+        // said EventStream and store it in the container. Otherwise simply increment the EventStream reference counter.
+        if (m_container->getEventStreams().find(type) == m_container->getEventStreams().end())
+        {
+            std::cout << "______________A new EventStream<" << type << "> has been created______________" << std::endl;
+            EventStream<Args...>* es = new EventStream;
+            m_container->addEventStream(type, static_cast<void*>(es));
+            m_container->addEventStreamRefCount(type);
+            return es;
+        }
+        else
+        {
+            std::cout << "______________EventStream<" << type << "> already exists______________" << std::endl;
+            m_container->addEventStreamRefCount(type);
+            return static_cast<EventStream<Args...>*>(m_container->getEventStreams()[type]);
+        }
+    }
+
+    // Create a new Event. A constexpr EventKey can be passed in to have the name hashed at compile time.
+    void create(const EventKey& eventName)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        // Note that if the event we try to define already exists in the global container, simply increment its reference count.
+        if (getEvent(eventName) != nullptr)
+        {
+            if (!m_container->addEventRefCount(eventName))
+            {
+                std::cout << "ERROR: Event name " << eventName.name() << " collides with the key of another Event; unable to create." << std::endl;
+            }
+        }
+        else
+        {
+            Event<Args...>* newEvent = new Event<Args...>;
+            if (m_container->addEvent(eventName, static_cast<void*>(newEvent)))
+            {
+                m_container->addEventRefCount(eventName);
+                newEvent->setName(std::string(eventName.name()));
+                m_container->addMetricsSource(eventName, [newEvent] { return newEvent->metrics(); });
+
+                // Apply the affinity the configuration file gives the Event, if any.
+                std::string affinity = m_container->getEventAffinity(std::string(eventName.name()));
+                if (!affinity.empty())
+                {
+                    if (std::optional<Affinity> parsed = Affinity::parse(affinity))
+                    {
+                        newEvent->setAffinity(*parsed);
+                    }
+                    else
+                    {
+                        std::cout << "Unable to read the affinity " << affinity << " of Event " << eventName.name() << "; default to the worker pool" << std::endl;
+                    }
+                }
+
+                // Hook the new Event up to the wildcard subscriptions whose patterns match its name.
+                const std::string& topic = m_topics.emplace(eventName.hash(), std::string(eventName.name())).first->second;
+                if (!m_patterns.empty())
+                {
+                    for (size_t patternId : m_patterns.match(topic))
+                    {
+                        attachPattern(m_patternSubscriptions.at(patternId), topic);
+                    }
+                }
+            }
+            else
+            {
+                std::cout << "ERROR: Event name " << eventName.name() << " collides with the key of another Event; unable to create." << std::endl;
+                delete newEvent;
+            }
+        }
+    }
+
+    // Destroy the Event specified by its name.
+    void destroy(const EventKey& eventName)
+    {
+        std::cout << "We've called into es->destroy(" << eventName.name() << ")" << std::endl;
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        Event<Args...>* eventPtr = getEvent(eventName);
+        if (eventPtr == nullptr)
+        {
+            std::cout << "Event with name " << eventName.name() << " could not be found, and thus cannot be destroyed." << std::endl;
+            return;
+        }
+
+        size_t cnt = m_container->getEventRefCount()[eventName.hash()];
+        std::cout << "cnt = " << cnt << std::endl;
+
+        // If multiple references to a specific event exist, simply decrement the overall count.
+        if (cnt > 1)
+        {
+            m_container->subtractEventRefCount(eventName);
+        }
+        else
+        {
+            // Wait for the Event to finish executing any handlers in the middle of computation before deleting. The handlers may
+            // still be queued on the worker pool (possibly behind the task calling destroy, when the pool has a single worker), so
+            // help run pending tasks while waiting, like Completion::wait does. A handler that never returns keeps the Event
+            // alive, so say which Event we're stuck on rather than hanging silently.
+            auto nextReport = std::chrono::steady_clock::now() + DestroyReportInterval;
+            while (!eventPtr->isExecutionComplete())
+            {
+                if (!m_container->runPendingTask())
+                {
+                    std::this_thread::yield();
+                }
+                if (std::chrono::steady_clock::now() >= nextReport)
+                {
+                    std::cout << "Still waiting for the handlers of Event " << eventName.name() << " to return before destroying it." << std::endl;
+                    nextReport += DestroyReportInterval;
+                }
+            }
+            m_container->eraseMetricsSource(eventName);
+            delete eventPtr;
+            m_container->eraseEvent(eventName);
+            m_container->eraseEventRefCount(eventName);
+            eventPtr = nullptr;
+
+            auto topic = m_topics.find(eventName.hash());
+            if (topic != m_topics.end())
+            {
+                for (size_t patternId : m_patterns.match(topic->second))
+                {
+                    m_patternSubscriptions.at(patternId).attached.erase(eventName.hash());
+                }
+                m_topics.erase(topic);
+            }
+        }
+    }
+
+    // Look up a name-specified Event once and return a handle to it that can be called/subscribed to without any further lookups.
+    // Returns an invalid EventRef if no such Event exists.
+    EventRef resolve(const EventKey& eventName)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return EventRef(std::string(eventName.name()), event);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to resolve." << std::endl;
+            return EventRef();
+        }
+    }
+
+    // Subscribe multiple methods simultaneously to a named Event using a vector of std::functions. Returns a vector of unique ids that 
+    // map to the handler functions we subscribed.
+    std::vector<size_t> subscribe(const EventKey& eventName, const std::vector<std::function<void(Args...)>>& handlerFuncs)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->add(handlerFuncs);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Subscribe multiple methods simultaneously to a named Event using a vector of function pointers. Returns a vector of unique ids that
+    // map to the handler functions we subscribed.
+    std::vector<size_t> subscribe(const EventKey& eventName, const std::vector<void(*)(Args...)>& handlerFuncs)
+    {
+        if (getEvent(eventName) != nullptr)
+        {
+            std::vector<std::function<void(Args...)>> _v; _v.reserve(handlerFuncs.size());
+            for (int i = 0; i < handlerFuncs.size(); ++i)
+            {
+                std::function<void(Args...)> _f = handlerFuncs[i];
+                _v.push_back(_f);
+            }
+            return subscribe(eventName, _v);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Subscribe multiple methods simultaneously to a named Event using variadic argument. Returns a  vector of unique ids that map to the 
+    // handler functions we subscribed.
+    template<typename T, typename... Args2>
+    std::vector<size_t> subscribe(const EventKey& eventName, T firstHandlerFunc, Args2... handlerFuncs)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            typedef void(*funcType)(Args...);
+            // Use std::conjunction to check if the templated typenames correspond to valid function types.
+            if constexpr ((std::conjunction_v<std::is_same<std::function<void(Args...)>, T>> && std::conjunction_v<std::is_same<std::function<void(Args...)>, Args2>...>)
+                || (std::conjunction_v<std::is_same<funcType, T>> && std::conjunction_v<std::is_same<funcType, Args2>...>))
+            {
+                T handlerFuncsArr[sizeof...(handlerFuncs) + 1] = { firstHandlerFunc, handlerFuncs... };
+                int cnt = sizeof(handlerFuncsArr) / sizeof(handlerFuncsArr[0]);
+
+                std::vector<T> handlerFuncsVector(handlerFuncsArr, handlerFuncsArr + cnt);
+
+                return subscribe(eventName, handlerFuncsVector);
+            }
+
+            // Any other callables (e.g. lambdas) are stored in their EventHandlers directly, without being wrapped in std::functions first.
+            else if constexpr (std::is_invocable_v<T&, const Args&...> && std::conjunction_v<std::is_invocable<Args2&, const Args&...>...>)
+            {
+                std::vector<EventHandler<Args...>> handlers; handlers.reserve(sizeof...(handlerFuncs) + 1);
+                handlers.emplace_back(std::move(firstHandlerFunc));
+                (handlers.emplace_back(std::move(handlerFuncs)), ...);
+
+                return event->add(handlers);
+            }
+
+            else
+            {
+                std::cout << "ERROR: Invalid argument type for subscription; unable to perform subscription." << std::endl;
+                return std::vector<size_t>();
+            }
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Subscribe a batch handler to a named Event. Instead of being called once per call, a batch handler is called with a pointer
+    // to a contiguous array of Payloads and its length, once per delivery: with everything posted to the Event since the last
+    // time its queue was drained (e.g. once per runner tick), with the whole batch of a callBatch, or with the single payload
+    // of a call/callAsync. Returns a unique id that can be passed to unsubscribe(), or 0 if the subscription failed.
+    template<typename F>
+    size_t subscribeBatch(const EventKey& eventName, F handlerFunc)
+    {
+        static_assert(std::is_invocable_v<F&, const Payload*, size_t>, "A batch handler must be callable with (const Payload*, size_t).");
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->addBatch(EventBatchHandler<Args...>(std::move(handlerFunc)));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+    // Subscribe a callable to a named Event, thinning out its calls with a rate limit: RateLimit::throttle(interval) to run at
+    // most once per interval, RateLimit::debounce(interval) to run with the latest arguments once the calls have stopped for an
+    // interval, or RateLimit::sample(n) to run on every nth call. The calls a subscription skips are filtered out by the
+    // dispatcher before the callable is reached. Debounced callables run on the Event's rate timer thread. Returns a unique id
+    // that can be passed to unsubscribe(), or 0 if the subscription failed.
+    template<typename F>
+    size_t subscribeLimited(const EventKey& eventName, RateLimit limit, F handlerFunc)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->addLimited(limit, std::move(handlerFunc));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+    // Subscribe a batch handler to a named Event that's handed the calls of each interval together (e.g. every mouse motion of
+    // the last 100 ms), as a pointer to a contiguous array of Payloads and its length, on the Event's rate timer thread.
+    // Returns a unique id that can be passed to unsubscribe(), or 0 if the subscription failed.
+    template<typename F>
+    size_t subscribeWindowed(const EventKey& eventName, std::chrono::nanoseconds interval, F handlerFunc)
+    {
+        static_assert(std::is_invocable_v<F&, const Payload*, size_t>, "A windowed handler must be callable with (const Payload*, size_t).");
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->addWindowed(interval, std::move(handlerFunc));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+    // Subscribe a single callable to a named Event with a priority. Handlers with lower priorities are called first (handlers
+    // subscribed without one have priority 0), and handlers with equal priorities are called in the order they were subscribed.
+    // Returns a vector holding the unique id of the subscribed handler.
+    template<typename F, typename P, typename = std::enable_if_t<std::is_invocable_v<F&, const Args&...> && std::is_integral_v<P>>>
+    std::vector<size_t> subscribe(const EventKey& eventName, F handlerFunc, P priority)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return std::vector<size_t>(1, event->add(EventHandler<Args...>(std::move(handlerFunc)), static_cast<int>(priority)));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Subscribe a single callable to a named Event with an executor affinity, which decides where it runs when the Event is called
+    // asynchronously: Affinity::pool(), Affinity::caller(), Affinity::executor(name) or Affinity::pinned(core) (see Affinity).
+    // Returns a vector holding the unique id of the subscribed handler.
+    template<typename F, typename = std::enable_if_t<std::is_invocable_v<F&, const Args&...>>>
+    std::vector<size_t> subscribe(const EventKey& eventName, F handlerFunc, const Affinity& affinity)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return std::vector<size_t>(1, event->add(EventHandler<Args...>(std::move(handlerFunc)), affinity));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Set where the handlers of a name-specified Event that were subscribed without an affinity run when it's called asynchronously.
+    void setAffinity(const EventKey& eventName, const Affinity& affinity)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->setAffinity(affinity);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to set its affinity." << std::endl;
+        }
+    }
+
+    // Subscribe a handler to every Event of this EventStream whose dotted name matches a wildcard pattern, e.g. "input.*" or
+    // "input.#" (see TopicTrie for the syntax), including the matching Events created later on. The pattern is only matched
+    // against Event names when it's subscribed and when an Event is created, and the handler is then attached to each matching
+    // Event like any other handler, so publishing to a matching Event costs exactly what it would for a direct subscription.
+    // The handler can optionally take the name of the Event being delivered (as an std::string_view) before the Event's own
+    // arguments. Returns an id that can be passed to unsubscribePattern().
+    template<typename F>
+    size_t subscribePattern(const std::string& pattern, F handlerFunc, int priority = 0)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        size_t patternId = m_nextPatternId++;
+        PatternSubscription& subscription = m_patternSubscriptions[patternId];
+        subscription.pattern = pattern;
+        subscription.priority = priority;
+        if constexpr (std::is_invocable_v<F&, std::string_view, const Args&...>)
+        {
+            // Every copy shares the callable, and refers to the Event's name as stored in m_topics, which outlives the Event.
+            std::shared_ptr<F> shared = std::make_shared<F>(std::move(handlerFunc));
+            subscription.makeHandler = [shared](const std::string& topic)
+            {
+                const std::string* name = &topic;
+                return EventHandler<Args...>([shared, name](const Args&... params) { (*shared)(std::string_view(*name), params...); });
+            };
+        }
+        else
+        {
+            static_assert(std::is_invocable_v<F&, const Args&...>, "A pattern handler must be callable with the Event's arguments, optionally preceded by the Event's name.");
+            EventHandler<Args...> handler(std::move(handlerFunc));
+            subscription.makeHandler = [handler](const std::string&) { return handler; };
+        }
+
+        m_patterns.insert(pattern, patternId);
+        TopicTrie single;
+        single.insert(pattern, patternId);
+        for (const auto& topic : m_topics)
+        {
+            if (!single.match(topic.second).empty())
+            {
+                attachPattern(subscription, topic.second);
+            }
+        }
+        return patternId;
+    }
+
+    // Remove a wildcard subscription (see subscribePattern()) from every Event it was attached to.
+    void unsubscribePattern(size_t patternId)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        auto subscription = m_patternSubscriptions.find(patternId);
+        if (subscription == m_patternSubscriptions.end())
+        {
+            std::cout << "No wildcard subscription with id " << patternId << " exists; unable to perform unsubscription." << std::endl;
+            return;
+        }
+
+        for (const auto& attached : subscription->second.attached)
+        {
+            if (Event<Args...>* event = getEvent(m_topics.at(attached.first)))
+            {
+                event->remove_id(attached.second);
+            }
+        }
+        m_patterns.erase(subscription->second.pattern, patternId);
+        m_patternSubscriptions.erase(subscription);
+    }
+
+    // Unsubscribe multiple functions simultaneously from an Event using a list of unique ids that map
+    // to each handler.
+    void unsubscribe(const EventKey& eventName, const std::vector<size_t>& handlerIds)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->remove_id(handlerIds);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform unsubscription." << std::endl;
+        }
+    }
+
+    // Unsubscribe multiple functions simultaneously from an Event using a variadic input of unique ids that map
+    // to each handler.
+    template<typename Arg1, typename... Args2>
+    void unsubscribe(const EventKey& eventName, Arg1 firstId, Args2... handlerIds)
+    {
+        if (getEvent(eventName) != nullptr)
+        {
+            if ((std::conjunction_v<std::is_same<size_t, Arg1>> && std::conjunction_v<std::is_same<size_t, Args2>...>)
+                || (std::conjunction_v<std::is_same<int, Arg1>> && std::conjunction_v<std::is_same<int, Args2>...>)
+                || (std::conjunction_v<std::is_same<unsigned int, Arg1>> && std::conjunction_v<std::is_same<unsigned int, Args2>...>))
+            {
+                Arg1 handlerIdsArr[sizeof...(handlerIds) + 1] = { firstId, handlerIds... };
+                int cnt = sizeof(handlerIdsArr) / sizeof(handlerIdsArr[0]);
+                std::vector<size_t> handlerIdsVector(handlerIdsArr, handlerIdsArr + cnt);
+
+                return unsubscribe(eventName, handlerIdsVector);
+            }
+
+            else
+            {
+                std::cout << "ERROR: Invalid argument type for unsubscription; unable to perform unsubscription." << std::endl;
+            }
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform unsubscription." << std::endl;
+        }
+    }
+
+    // Run f once, with the arguments of the next call to a name-specified Event (however it gets delivered: call, callAsync,
+    // dispatch or a drain of posted calls), on the thread that delivers it. Nothing waits in the meantime. Returns an id that can
+    // be passed to unsubscribe() to cancel it, or 0 if the Event doesn't exist.
+    template<typename F>
+    size_t once(const EventKey& eventName, F handlerFunc)
+    {
+        return when(eventName, [](const Args&...) { return true; }, std::move(handlerFunc));
+    }
+
+    // Run f once, with the arguments of the first call to a name-specified Event for which pred returns true (see once()).
+    template<typename Pred, typename F>
+    size_t when(const EventKey& eventName, Pred pred, F handlerFunc)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->addOnce(std::move(pred), std::move(handlerFunc));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+#ifdef EVENT_HAS_COROUTINES
+    // Awaitable form of once()/when(): co_await es->next("runner") suspends the calling coroutine until the next call to the
+    // Event, and yields that call's payload (the argument itself for single-argument Events, an std::tuple otherwise). The
+    // suspended coroutine only costs its frame; the thread delivering the Event resumes it. Yields an empty optional, without
+    // suspending, if the Event doesn't exist. A coroutine still waiting when its Event is destroyed is never resumed.
+    template<typename Pred> class EventAwaiter
+    {
+    public:
+        EventAwaiter(Event<Args...>* event, Pred pred)
+            : m_event(event), m_pred(std::move(pred))
+        {}
+
+        bool await_ready() const noexcept
+        {
+            return m_event == nullptr;
+        }
+
+        // The coroutine may be resumed on another thread before this returns, so nothing here touches the awaiter after addOnce.
+        void await_suspend(std::coroutine_handle<> coroutine)
+        {
+            m_event->addOnce(std::move(m_pred), [this, coroutine](const Args&... params)
+            {
+                m_payload.emplace(params...);
+                coroutine.resume();
+            });
+        }
+
+        std::optional<Payload> await_resume()
+        {
+            return std::move(m_payload);
+        }
+
+    private:
+        Event<Args...>* m_event;
+        Pred m_pred;
+        std::optional<Payload> m_payload;
+    };
+
+    auto next(const EventKey& eventName)
+    {
+        return when(eventName, [](const Args&...) { return true; });
+    }
+
+    // co_await es->when("input_keyboard", pred) resumes on the first call to the Event whose arguments satisfy pred.
+    template<typename Pred>
+    EventAwaiter<Pred> when(const EventKey& eventName, Pred pred)
+    {
+        Event<Args...>* event = getEvent(eventName);
+        if (event == nullptr)
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to await it." << std::endl;
+        }
+        return EventAwaiter<Pred>(event, std::move(pred));
+    }
+#endif
+
+    // Sequentially call each EventHandler in a name-specified Event.
+    void call(const EventKey& eventName, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->call(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to call." << std::endl;
+        }
+    }
+
+    // Call each EventHandler in a name-specified Event once per set of arguments in the batch, looking the Event up and taking
+    // its handler snapshot only once. Handlers are run one after the other, each over the whole batch (see Event::callBatch).
+    void callBatch(const EventKey& eventName, const std::tuple<Args...>* payloads, size_t count)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->callBatch(payloads, count);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to callBatch." << std::endl;
+        }
+    }
+
+    void callBatch(const EventKey& eventName, const std::vector<std::tuple<Args...>>& payloads)
+    {
+        callBatch(eventName, payloads.data(), payloads.size());
+    }
+
+    // Allows one to run the same name-specified Event in multiple threads.
+    std::future<void> callAsyncBlocking(const EventKey& eventName, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->callAsyncBlocking(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to callAsyncBlocking." << std::endl;
+            return std::future<void>();
+        }
+    }
+
+    // Run the EventHandlers for a name-specified Event concurrently on the shared worker pool.
+    void callAsync(const EventKey& eventName, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->callAsync(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to callAsync." << std::endl;
+        }
+    }
+
+    // Run the EventHandlers for a name-specified Event concurrently on the shared worker pool without waiting for them. The
+    // returned Completion becomes ready once they've all finished; it's already ready if the Event doesn't exist.
+    Completion dispatch(const EventKey& eventName, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->dispatch(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to dispatch." << std::endl;
+            return Completion();
+        }
+    }
+
+    // Dispatch a call to a name-specified Event with a deadline: once the budget has elapsed, the watchdog reports the handlers
+    // still running (naming the plugins that subscribed them) and applies the overrun policy to them (see OverrunPolicy). The
+    // returned Completion doubles as the dispatch's cancellation token, and is already ready if the Event doesn't exist.
+    Completion dispatchWithin(const EventKey& eventName, std::chrono::nanoseconds budget, OverrunPolicy policy, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->dispatchWithin(budget, policy, params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to dispatch." << std::endl;
+            return Completion();
+        }
+    }
+
+    // Deliver a call to a name-specified Event on the shared worker pool, in order with the other calls made with the same key (see
+    // Event::dispatchOrdered). The returned Completion is already ready if the Event doesn't exist.
+    Completion dispatchOrdered(const EventKey& eventName, size_t key, const Args&... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->dispatchOrdered(key, params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to dispatch." << std::endl;
+            return Completion();
+        }
+    }
+
+    // Queue up a call to a name-specified Event; its handlers run when the Event's queue is drained (see drainPosted()). Returns
+    // false if the Event doesn't exist or its queue is full.
+    bool post(const EventKey& eventName, Args... params)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->post(std::move(params)...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to post." << std::endl;
+            return false;
+        }
+    }
+
+    // Run the handlers for the calls posted to a name-specified Event so far, on the calling thread. Returns the number of posted
+    // calls that were dispatched.
+    size_t drainPosted(const EventKey& eventName)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->drainPosted();
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to drain." << std::endl;
+            return 0;
+        }
+    }
+
+    // Turn conflation of the calls posted to a name-specified Event on or off. While it is on, a post replaces the undelivered call
+    // with the same key (computed by keyOf, or shared by all calls if there is none), so the handlers only see the latest state.
+    void setConflation(const EventKey& eventName, bool enabled, std::function<size_t(const Args&...)> keyOf = nullptr)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->setConflation(enabled, std::move(keyOf));
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to set conflation." << std::endl;
+        }
+    }
+
+    // Give every dispatch of a name-specified Event a deadline, and choose what the watchdog does about the handlers that overrun
+    // it (see dispatchWithin). A budget of zero removes the deadline.
+    void setDeadline(const EventKey& eventName, std::chrono::nanoseconds budget, OverrunPolicy policy = OverrunPolicy::Report)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->setDeadline(budget, policy);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to set its deadline." << std::endl;
+        }
+    }
+
+    // Make a name-specified Event sticky, so handlers subscribed after it last fired are handed its latest arguments straight
+    // away (see Event::setSticky), or stop it being sticky.
+    void setSticky(const EventKey& eventName, bool enabled)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->setSticky(enabled);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to set stickiness." << std::endl;
+        }
+    }
+
+    // Bound the queued and asynchronous calls of a name-specified Event, and choose what happens to new calls once it's at
+    // capacity: block the producer, drop the oldest or the newest call, or coalesce calls with the same key (see
+    // Event::setQueuePolicy for the details).
+    void setQueuePolicy(const EventKey& eventName, size_t capacity, QueuePolicy policy)
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            event->setQueuePolicy(capacity, policy);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to set its queue policy." << std::endl;
+        }
+    }
+
+    // The overload counters of a name-specified Event (all zero if it doesn't exist).
+    QueueStats queueStats(const EventKey& eventName) const
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->queueStats();
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to get its queue stats." << std::endl;
+            return QueueStats();
+        }
+    }
+
+    // The dispatch metrics of a name-specified Event (empty if it doesn't exist). Container::getEventMetrics returns the same
+    // metrics for any Event, whatever its EventStream.
+    EventMetrics metrics(const EventKey& eventName) const
+    {
+        if (Event<Args...>* event = getEvent(eventName))
+        {
+            return event->metrics();
+        }
 
-            m_handlers = src.m_handlers;
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to get its metrics." << std::endl;
+            return EventMetrics();
+        }
+    }
 
-            return *this;
+    // Drain the queues of every Event that has been posted to (no matter the EventStream it belongs to) on the calling thread.
+    // Meant to be called once per frame/tick by whatever plays the role of the main loop, e.g. the runner. Returns the number of
+    // posted calls that were dispatched.
+    size_t drainPosted()
+    {
+        return m_container->drainPostedQueues();
+    }
+
+    // Subscribe multiple methods simultaneously to a resolved Event using a vector of std::functions. Returns a vector of unique ids
+    // that map to the handler functions we subscribed.
+    std::vector<size_t> subscribe(const EventRef& event, const std::vector<std::function<void(Args...)>>& handlerFuncs)
+    {
+        if (event)
+        {
+            return event.m_event->add(handlerFuncs);
         }
 
-        // Move assignment operator.
-        Event<Args2...>& operator=(Event<Args2...>&& src)
+        else
         {
-            std::lock_guard<std::recursive_mutex> lock(m_handlersLocker);
-            std::lock_guard<std::recursive_mutex> lock2(src.m_handlersLocker);
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
 
-            std::swap(m_handlers, src.m_handlers);
+    // Subscribe any number of callables (std::functions, function pointers, lambdas) to a resolved Event. Returns a vector of unique
+    // ids that map to the handler functions we subscribed.
+    template<typename T, typename... Args2, typename = std::enable_if_t<std::is_invocable_v<T&, const Args&...>>>
+    std::vector<size_t> subscribe(const EventRef& event, T firstHandlerFunc, Args2... handlerFuncs)
+    {
+        static_assert(std::conjunction_v<std::is_invocable<Args2&, const Args&...>...>, "Every handler must be callable with the Event's arguments.");
+        if (event)
+        {
+            std::vector<EventHandler<Args...>> handlers; handlers.reserve(sizeof...(handlerFuncs) + 1);
+            handlers.emplace_back(std::move(firstHandlerFunc));
+            (handlers.emplace_back(std::move(handlerFuncs)), ...);
 
-            return *this;
+            return event.m_event->add(handlers);
         }
 
-        // Atomic flag used to determine if all EventHandlers subscribed to an Event have finished executing.
-        std::atomic<bool> isExecutionComplete = true;
-        // Atomic flag used to determine if the subscription of EventHandlers has completed.
-        std::atomic<bool> isSubscriptionComplete = true;
-        // Atomic flag used to determine if the unsubscription of EventHandlers has completed.
-        std::atomic<bool> isUnsubscriptionComplete = true;
+        else
+        {
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
 
-    private:
-        std::recursive_mutex m_handlersLocker;
-        std::vector<EventHandler<Args2...>> m_handlers;
+    // Subscribe a single callable to a resolved Event with a priority (see the named-Event overload above). Returns a vector
+    // holding the unique id of the subscribed handler.
+    template<typename F, typename P, typename = std::enable_if_t<std::is_invocable_v<F&, const Args&...> && std::is_integral_v<P>>>
+    std::vector<size_t> subscribe(const EventRef& event, F handlerFunc, P priority)
+    {
+        if (event)
+        {
+            return std::vector<size_t>(1, event.m_event->add(EventHandler<Args...>(std::move(handlerFunc)), static_cast<int>(priority)));
+        }
 
-        // Helper function for call(Args... params). Simply loops through all handles in the Event
-        // and calls them in the order that they are stored.
-        void callImpl(const std::vector<EventHandler<Args2...>>& handlers, Args2... params) const
+        else
         {
-            //std::cout << "Num Handles: " << handlers.size() << std::endl;
-            for (const auto& handler : handlers)
-            {
-                handler(params...);
-            }
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
         }
+    }
 
-        // Helper function for callAsync(Args... params). Spawns entirely-separate threads for each subscribed handle to 
-        // be executed in. The method then waits for all threads to finish executing before joining them back together.
-        void callAsyncImpl(const std::vector<EventHandler<Args2...>>& handlers, Args2... params)
+    // Subscribe a single callable to a resolved Event with an executor affinity (see the named-Event overload above). Returns a
+    // vector holding the unique id of the subscribed handler.
+    template<typename F, typename = std::enable_if_t<std::is_invocable_v<F&, const Args&...>>>
+    std::vector<size_t> subscribe(const EventRef& event, F handlerFunc, const Affinity& affinity)
+    {
+        if (event)
         {
-            std::vector<std::thread> threads;
-            std::vector<bool> threadStatus;
-            
-            threads.reserve(handlers.size());
-            threadStatus.reserve(handlers.size());
+            return std::vector<size_t>(1, event.m_event->add(EventHandler<Args...>(std::move(handlerFunc)), affinity));
+        }
 
-            int cnt = 0;
-            for (const auto& handler : handlers)
-            {
-                threadStatus.push_back(false);
-                // Run some task on a new thread. Make sure to set the done flag to true when finished.
-                threads.push_back(std::thread([&threadStatus, cnt, handler, params...]{ handler(params...); threadStatus[cnt] = true; }));
-                ++cnt;
-            }
+        else
+        {
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
 
-            while (cnt > 0)
-            {
-                for (size_t i = 0; i < threadStatus.size(); ++i)
-                {
-                    if (threadStatus[i])
-                    {
-                        --cnt;
-                    }
-                }
-            }
+    // Set where the handlers of a resolved Event that were subscribed without an affinity run when it's called asynchronously.
+    void setAffinity(const EventRef& event, const Affinity& affinity)
+    {
+        if (event)
+        {
+            event.m_event->setAffinity(affinity);
+        }
 
-            for (size_t i = 0; i < threads.size(); ++i)
-            {
-                threads[i].join();
-            }
+        else
+        {
+            std::cout << "Invalid EventRef; unable to set its affinity." << std::endl;
+        }
+    }
 
-            threadStatus.clear();
-            threads.clear();
+    // Subscribe a batch handler to a resolved Event (see subscribeBatch() above). Returns a unique id that can be passed to
+    // unsubscribe(), or 0 if the subscription failed.
+    template<typename F>
+    size_t subscribeBatch(const EventRef& event, F handlerFunc)
+    {
+        static_assert(std::is_invocable_v<F&, const Payload*, size_t>, "A batch handler must be callable with (const Payload*, size_t).");
+        if (event)
+        {
+            return event.m_event->addBatch(EventBatchHandler<Args...>(std::move(handlerFunc)));
         }
-    };
 
-public:
-    void requestDelete()
+        else
+        {
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+    // Subscribe a rate-limited callable to a resolved Event (see the named-Event overload above).
+    template<typename F>
+    size_t subscribeLimited(const EventRef& event, RateLimit limit, F handlerFunc)
     {
-        // Use the function signature of requestDelete() to obtain the EventStream's templated specialization type.
-        #ifdef _WIN32
-        std::string type = esType(__FUNCSIG__);
-        #elif __linux__
-        std::string type = esType(__PRETTY_FUNCTION__);
-        #endif
+        if (event)
+        {
+            return event.m_event->addLimited(limit, std::move(handlerFunc));
+        }
 
-        std::cout << "_______________EventStream<" << type << "> requestDelete has been called_______________" << std::endl;
-        
-        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        else
         {
-            std::cout << "EventStream<" << type << "> count BEFORE: " << m_container->getEventStreamRefCount().at(type) << std::endl;
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return 0;
+        }
+    }
+
+    // Subscribe a windowed batch handler to a resolved Event (see the named-Event overload above).
+    template<typename F>
+    size_t subscribeWindowed(const EventRef& event, std::chrono::nanoseconds interval, F handlerFunc)
+    {
+        static_assert(std::is_invocable_v<F&, const Payload*, size_t>, "A windowed handler must be callable with (const Payload*, size_t).");
+        if (event)
+        {
+            return event.m_event->addWindowed(interval, std::move(handlerFunc));
         }
+
         else
         {
-            std::cout << "EventStream<" << type << "> count BEFORE: " << 0 << std::endl;
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return 0;
         }
+    }
 
-        // If the EventStream type is not even present in the container, do nothing.
-        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+    // Unsubscribe multiple functions simultaneously from a resolved Event using a list of unique ids that map to each handler.
+    void unsubscribe(const EventRef& event, const std::vector<size_t>& handlerIds)
+    {
+        if (event)
         {
-            // If only one reference exists for the EventStream we wish to delete, then destruct that EventStream. Otherwise
-            // simply decrement its reference counter.
-            if (m_container->getEventStreamRefCount().at(type) > 1)
-            {
-                m_container->subtractEventStreamRefCount(type);
-            }
-            else
-            {
-                delete static_cast<EventStream<Args...>*>(m_container->getEventStreams().at(type));
-                m_container->eraseEventStream(type);
-                m_container->eraseEventStreamRefCount(type);
-            }
+            event.m_event->remove_id(handlerIds);
         }
 
-        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        else
         {
-            std::cout << "EventStream<" << type << "> count AFTER: " << m_container->getEventStreamRefCount().at(type) << std::endl;
+            std::cout << "Invalid EventRef; unable to perform unsubscription." << std::endl;
+        }
+    }
+
+    // Run f once, with the arguments of the next call to a resolved Event (see the named-Event overload above).
+    template<typename F>
+    size_t once(const EventRef& event, F handlerFunc)
+    {
+        return when(event, [](const Args&...) { return true; }, std::move(handlerFunc));
+    }
+
+    // Run f once, with the arguments of the first call to a resolved Event for which pred returns true.
+    template<typename Pred, typename F>
+    size_t when(const EventRef& event, Pred pred, F handlerFunc)
+    {
+        if (event)
+        {
+            return event.m_event->addOnce(std::move(pred), std::move(handlerFunc));
         }
+
         else
         {
-            std::cout << "EventStream<" << type << "> count AFTER: " << 0 << std::endl;
+            std::cout << "Invalid EventRef; unable to perform subscription." << std::endl;
+            return 0;
         }
     }
 
-    // Note that EventStream is a singleton. The size_t identifier is a hashed representation of the app's executable
-    // directory.
-    static EventStream* Instance(size_t identifier)
+#ifdef EVENT_HAS_COROUTINES
+    // Awaitable forms of once()/when() for a resolved Event (see EventAwaiter above).
+    auto next(const EventRef& event)
     {
-        loadContainer(identifier);
+        return when(event, [](const Args&...) { return true; });
+    }
 
-        // Use the function signature of Instance() to obtain the EventStream's templated specialization type.
-        #ifdef _WIN32
-        std::string type = esType(__FUNCSIG__);
-        #elif __linux__
-        std::string type = esType(__PRETTY_FUNCTION__);
-        #endif
+    template<typename Pred>
+    EventAwaiter<Pred> when(const EventRef& event, Pred pred)
+    {
+        if (!event)
+        {
+            std::cout << "Invalid EventRef; unable to await it." << std::endl;
+        }
+        return EventAwaiter<Pred>(event.m_event, std::move(pred));
+    }
+#endif
 
-        // If the template specialization of EventStream we wish to create doesn't already exist, create a new instance of
-        // said EventStream and store it in the container. Otherwise simply increment the EventStream reference counter.
-        if (m_container->getEventStreams().find(type) == m_container->getEventStreams().end())
+    // Sequentially call each EventHandler in a resolved Event.
+    void call(const EventRef& event, const Args&... params)
+    {
+        if (event)
         {
-            std::cout << "______________A new EventStream<" << type << "> has been created______________" << std::endl;
-            EventStream<Args...>* es = new EventStream;
-            m_container->addEventStream(type, static_cast<void*>(es));
-            m_container->addEventStreamRefCount(type);
-            return es;
+            event.m_event->call(params...);
         }
+
         else
         {
-            std::cout << "______________EventStream<" << type << "> already exists______________" << std::endl;
-            m_container->addEventStreamRefCount(type);
-            return static_cast<EventStream<Args...>*>(m_container->getEventStreams()[type]);
+            std::cout << "Invalid EventRef; unable to call." << std::endl;
         }
     }
 
-    // Create a new Event.
-    void create(std::string eventName)
+    // Call each EventHandler in a resolved Event once per set of arguments in the batch (see Event::callBatch).
+    void callBatch(const EventRef& event, const std::tuple<Args...>* payloads, size_t count)
     {
-        // Note that if the event we try to define already exists in the global container, simply increment its reference count.
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            m_container->addEventRefCount(eventName);
+            event.m_event->callBatch(payloads, count);
         }
+
         else
         {
-            Event<Args...>* newEvent = new Event<Args...>;
-            m_container->addEvent(eventName, static_cast<void*>(newEvent));
-            m_container->addEventRefCount(eventName);
+            std::cout << "Invalid EventRef; unable to callBatch." << std::endl;
         }
     }
 
-    // Destroy the Event specified by its name.
-    void destroy(std::string eventName)
+    void callBatch(const EventRef& event, const std::vector<std::tuple<Args...>>& payloads)
     {
-        std::cout << "We've called into es->destroy(" + eventName + ")" << std::endl;
-        std::lock_guard<std::recursive_mutex> lock(m_lock);
+        callBatch(event, payloads.data(), payloads.size());
+    }
 
-        size_t cnt = m_container->getEvents().count(eventName);
-        std::cout << "cnt = " << cnt << std::endl;
-        if (cnt == 0)
+    // Allows one to run the same resolved Event in multiple threads.
+    std::future<void> callAsyncBlocking(const EventRef& event, const Args&... params)
+    {
+        if (event)
         {
-            std::cout << "Event with name " << eventName << " could not be found, and thus cannot be destroyed." << std::endl;
-            return;
+            return event.m_event->callAsyncBlocking(params...);
         }
 
-        // If multiple references to a specific event exist, simply decrement the overall count.
-        if (cnt > 1)
+        else
         {
-            m_container->subtractEventRefCount(eventName);
+            std::cout << "Invalid EventRef; unable to callAsyncBlocking." << std::endl;
+            return std::future<void>();
+        }
+    }
+
+    // Run the EventHandlers for a resolved Event concurrently on the shared worker pool.
+    void callAsync(const EventRef& event, const Args&... params)
+    {
+        if (event)
+        {
+            event.m_event->callAsync(params...);
         }
+
         else
         {
-            Event<Args...>* eventPtr = static_cast<Event<Args...>*>(m_container->getEvents().at(eventName));
-            if (eventPtr != nullptr)
-            {
-                // Wait for the Event to finish executing any handlers in the middle of computation before deleting.
-                while (!eventPtr->isExecutionComplete)
-                {
-                    continue;
-                }
-                delete eventPtr;
-                m_container->eraseEvent(eventName);
-                m_container->eraseEventRefCount(eventName);
-                eventPtr = nullptr;
-            }
-            else
-            {
-                std::cout << "eventPtr is null" << std::endl;
-            }
+            std::cout << "Invalid EventRef; unable to callAsync." << std::endl;
         }
     }
 
-    // Subscribe multiple methods simultaneously to a named Event using a vector of std::functions. Returns a vector of unique ids that 
-    // map to the handler functions we subscribed.
-    std::vector<size_t> subscribe(std::string eventName, const std::vector<std::function<void(Args...)>>& handlerFuncs)
+    // Run the EventHandlers for a resolved Event on the shared worker pool without waiting for them (see dispatch() above).
+    Completion dispatch(const EventRef& event, const Args&... params)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            return static_cast<Event<Args...>*>(m_container->getEvents()[eventName])->add(handlerFuncs);
+            return event.m_event->dispatch(params...);
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to perform subscription." << std::endl;
-            return std::vector<size_t>();
+            std::cout << "Invalid EventRef; unable to dispatch." << std::endl;
+            return Completion();
         }
     }
 
-    // Subscribe multiple methods simultaneously to a named Event using a vector of function pointers. Returns a vector of unique ids that
-    // map to the handler functions we subscribed.
-    std::vector<size_t> subscribe(std::string eventName, const std::vector<void(*)(Args...)>& handlerFuncs)
+    // Dispatch a call to a resolved Event with a deadline (see the named-Event overload above).
+    Completion dispatchWithin(const EventRef& event, std::chrono::nanoseconds budget, OverrunPolicy policy, const Args&... params)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            std::vector<std::function<void(Args...)>> _v; _v.reserve(handlerFuncs.size());
-            for (int i = 0; i < handlerFuncs.size(); ++i)
-            {
-                std::function<void(Args...)> _f = handlerFuncs[i];
-                _v.push_back(_f);
-            }
-            return subscribe(eventName, _v);
+            return event.m_event->dispatchWithin(budget, policy, params...);
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to perform subscription." << std::endl;
-            return std::vector<size_t>();
+            std::cout << "Invalid EventRef; unable to dispatch." << std::endl;
+            return Completion();
         }
     }
 
-    // Subscribe multiple methods simultaneously to a named Event using variadic argument. Returns a  vector of unique ids that map to the 
-    // handler functions we subscribed.
-    template<typename T, typename... Args2>
-    std::vector<size_t> subscribe(std::string eventName, T firstHandlerFunc, Args2... handlerFuncs)
+    // Deliver a call to a resolved Event on the shared worker pool, in order with the other calls made with the same key.
+    Completion dispatchOrdered(const EventRef& event, size_t key, const Args&... params)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            typedef void(*funcType)(Args...);
-            // Use std::conjunction to check if the templated typenames correspond to valid function types.
-            if ((std::conjunction_v<std::is_same<std::function<void(Args...)>, T>> && std::conjunction_v<std::is_same<std::function<void(Args...)>, Args2>...>)
-                || (std::conjunction_v<std::is_same<funcType, T>> && std::conjunction_v<std::is_same<funcType, Args2>...>))
-            {
-                T handlerFuncsArr[sizeof...(handlerFuncs) + 1] = { firstHandlerFunc, handlerFuncs... };
-                int cnt = sizeof(handlerFuncsArr) / sizeof(handlerFuncsArr[0]);
+            return event.m_event->dispatchOrdered(key, params...);
+        }
 
-                std::vector<T> handlerFuncsVector(handlerFuncsArr, handlerFuncsArr + cnt);
+        else
+        {
+            std::cout << "Invalid EventRef; unable to dispatch." << std::endl;
+            return Completion();
+        }
+    }
 
-                return subscribe(eventName, handlerFuncsVector);
-            }
+    // Queue up a call to a resolved Event; its handlers run when the Event's queue is drained. Returns false if the ref is invalid
+    // or the queue is full.
+    bool post(const EventRef& event, Args... params)
+    {
+        if (event)
+        {
+            return event.m_event->post(std::move(params)...);
+        }
 
-            else
-            {
-                std::cout << "ERROR: Invalid argument type for subscription; unable to perform subscription." << std::endl;
-            }
+        else
+        {
+            std::cout << "Invalid EventRef; unable to post." << std::endl;
+            return false;
+        }
+    }
+
+    // Turn conflation of the calls posted to a resolved Event on or off (see setConflation() above).
+    void setConflation(const EventRef& event, bool enabled, std::function<size_t(const Args&...)> keyOf = nullptr)
+    {
+        if (event)
+        {
+            event.m_event->setConflation(enabled, std::move(keyOf));
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to perform subscription." << std::endl;
-            return std::vector<size_t>();
+            std::cout << "Invalid EventRef; unable to set conflation." << std::endl;
         }
     }
 
-    // Unsubscribe multiple functions simultaneously from an Event using a list of unique ids that map
-    // to each handler.
-    void unsubscribe(std::string eventName, const std::vector<size_t>& handlerIds)
+    // Give every dispatch of a resolved Event a deadline (see the named-Event overload above).
+    void setDeadline(const EventRef& event, std::chrono::nanoseconds budget, OverrunPolicy policy = OverrunPolicy::Report)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            static_cast<Event<Args...>*>(m_container->getEvents()[eventName])->remove_id(handlerIds);
+            event.m_event->setDeadline(budget, policy);
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to perform unsubscription." << std::endl;
+            std::cout << "Invalid EventRef; unable to set its deadline." << std::endl;
         }
     }
 
-    // Unsubscribe multiple functions simultaneously from an Event using a variadic input of unique ids that map
-    // to each handler.
-    template<typename Arg1, typename... Args2>
-    void unsubscribe(std::string eventName, Arg1 firstId, Args2... handlerIds)
+    // Make a resolved Event sticky, or stop it being sticky.
+    void setSticky(const EventRef& event, bool enabled)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            if ((std::conjunction_v<std::is_same<size_t, Arg1>> && std::conjunction_v<std::is_same<size_t, Args2>...>)
-                || (std::conjunction_v<std::is_same<int, Arg1>> && std::conjunction_v<std::is_same<int, Args2>...>)
-                || (std::conjunction_v<std::is_same<unsigned int, Arg1>> && std::conjunction_v<std::is_same<unsigned int, Args2>...>))
-            {
-                Arg1 handlerIdsArr[sizeof...(handlerIds) + 1] = { firstId, handlerIds... };
-                int cnt = sizeof(handlerIdsArr) / sizeof(handlerIdsArr[0]);
-                std::vector<size_t> handlerIdsVector(handlerIdsArr, handlerIdsArr + cnt);
+            event.m_event->setSticky(enabled);
+        }
 
-                return unsubscribe(eventName, handlerIdsVector);
-            }
+        else
+        {
+            std::cout << "Invalid EventRef; unable to set stickiness." << std::endl;
+        }
+    }
 
-            else
-            {
-                std::cout << "ERROR: Invalid argument type for unsubscription; unable to perform unsubscription." << std::endl;
-            }
+    // Bound the queued and asynchronous calls of a resolved Event (see the named-Event overload above).
+    void setQueuePolicy(const EventRef& event, size_t capacity, QueuePolicy policy)
+    {
+        if (event)
+        {
+            event.m_event->setQueuePolicy(capacity, policy);
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to perform unsubscription." << std::endl;
+            std::cout << "Invalid EventRef; unable to set its queue policy." << std::endl;
         }
     }
 
-    // Sequentially call each EventHandler in a name-specified Event.
-    void call(std::string eventName, Args... params)
+    // The overload counters of a resolved Event.
+    QueueStats queueStats(const EventRef& event) const
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            static_cast<Event<Args...>*>(m_container->getEvents()[eventName])->call(params...);
+            return event.m_event->queueStats();
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to call." << std::endl;
+            std::cout << "Invalid EventRef; unable to get its queue stats." << std::endl;
+            return QueueStats();
         }
     }
 
-    // Allows one to run the same name-specified Event in multiple threads.
-    std::future<void> callAsyncBlocking(std::string eventName, Args... params)
+    // The dispatch metrics of a resolved Event.
+    EventMetrics metrics(const EventRef& event) const
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            static_cast<Event<Args...>*>(m_container->getEvents()[eventName])->callAsyncBlocking(params...);
+            return event.m_event->metrics();
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to callAsyncBlocking." << std::endl;
-            return std::future<void>();
+            std::cout << "Invalid EventRef; unable to get its metrics." << std::endl;
+            return EventMetrics();
         }
     }
 
-    // Run each EventHandler for a name-specified Event in a separate thread.
-    void callAsync(std::string eventName, Args... params)
+    // Run the handlers for the calls posted to a resolved Event so far, on the calling thread.
+    size_t drainPosted(const EventRef& event)
     {
-        if (m_container->getEvents().count(eventName) > 0)
+        if (event)
         {
-            static_cast<Event<Args...>*>(m_container->getEvents()[eventName])->callAsync(params...);
+            return event.m_event->drainPosted();
         }
 
         else
         {
-            std::cout << "No Event named " << eventName << " exists; unable to callAsync." << std::endl;
+            std::cout << "Invalid EventRef; unable to drain." << std::endl;
+            return 0;
         }
     }
 };
@@ -0,0 +1,220 @@
+#ifndef EVENTMETRICS_H
+#define EVENTMETRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// LatencyHistogram counts durations (in nanoseconds) in log-scaled buckets, HDR-style: every power of two is split into
+// SubBuckets linear buckets, so a bucket's width is at most a quarter of the values it holds, and percentiles read back from
+// the histogram are within 25% of the real ones whatever their magnitude. Durations of 2^MaxBits ns (about 69 s) and more all
+// land in the last bucket.
+struct LatencyHistogram
+{
+    static constexpr size_t SubBucketBits = 2;
+    static constexpr size_t SubBuckets = size_t(1) << SubBucketBits;
+    static constexpr size_t MaxBits = 36;
+    static constexpr size_t BucketCount = (MaxBits - SubBucketBits + 1) * SubBuckets;
+
+    static size_t bucketOf(uint64_t nanoseconds)
+    {
+        if (nanoseconds < SubBuckets)
+        {
+            return static_cast<size_t>(nanoseconds);
+        }
+        size_t magnitude = 0;
+        for (uint64_t value = nanoseconds; value >>= 1; ++magnitude) {}
+        if (magnitude >= MaxBits)
+        {
+            return BucketCount - 1;
+        }
+        size_t subBucket = static_cast<size_t>(nanoseconds >> (magnitude - SubBucketBits)) & (SubBuckets - 1);
+        return (magnitude - SubBucketBits + 1) * SubBuckets + subBucket;
+    }
+
+    // Smallest duration that falls into a bucket.
+    static uint64_t lowerBound(size_t bucket)
+    {
+        if (bucket < SubBuckets)
+        {
+            return bucket;
+        }
+        size_t magnitude = bucket / SubBuckets + SubBucketBits - 1;
+        return (uint64_t(SubBuckets + bucket % SubBuckets)) << (magnitude - SubBucketBits);
+    }
+
+    uint64_t count() const
+    {
+        uint64_t total = 0;
+        for (uint64_t bucketCount : buckets)
+        {
+            total += bucketCount;
+        }
+        return total;
+    }
+
+    // The duration below which the given fraction (0 to 1) of the recorded durations fall, e.g. 0.99 for the 99th percentile.
+    // Reported as the upper end of the bucket the percentile falls into, so it errs on the slow side. 0 if nothing was recorded.
+    uint64_t percentile(double fraction) const
+    {
+        uint64_t total = count();
+        if (total == 0)
+        {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += buckets[i];
+            if (seen > rank || seen == total)
+            {
+                return i + 1 < BucketCount ? lowerBound(i + 1) - 1 : lowerBound(i);
+            }
+        }
+        return lowerBound(BucketCount - 1);
+    }
+
+    std::array<uint64_t, BucketCount> buckets{};
+};
+
+// Metrics of one handler of an Event.
+struct HandlerMetrics
+{
+    size_t id = 0;
+    std::string plugin;             // Plugin that subscribed the handler, if known.
+    uint64_t invocations = 0;
+    uint64_t totalNanoseconds = 0;  // Time spent in the handler, summed over its invocations.
+    LatencyHistogram latency;
+};
+
+// Metrics of an Event, as returned by Container::getEventMetrics and EventStream::metrics. The counts cover the Event's whole
+// lifetime; the handler metrics only cover the handlers currently subscribed.
+struct EventMetrics
+{
+    std::string name;
+    uint64_t published = 0;   // Calls made to the Event (call, callAsync, dispatch, post, and each payload of a callBatch).
+    uint64_t invocations = 0; // Handler invocations, summed over the handlers below.
+    size_t queueDepth = 0;    // Posted calls waiting to be drained, plus asynchronous calls still to be delivered.
+    std::vector<HandlerMetrics> handlers;
+};
+
+// Every thread records metrics into one of MetricStripes stripes, picked once per thread, so that threads publishing to the
+// same Event mostly write to cache lines of their own; reads add the stripes up. Recording is a handful of relaxed atomic
+// increments, and never takes a lock.
+constexpr size_t MetricStripes = 8;
+
+inline size_t metricStripe()
+{
+    static std::atomic<size_t> nextStripe(0);
+    static thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % MetricStripes;
+    return stripe;
+}
+
+// Striped count of an Event's calls.
+class PublishCounter
+{
+public:
+    void add(uint64_t count)
+    {
+        m_stripes[metricStripe()].value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t read() const
+    {
+        uint64_t total = 0;
+        for (const Stripe& stripe : m_stripes)
+        {
+            total += stripe.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Stripe m_stripes[MetricStripes];
+};
+
+// Striped invocation count and latency histogram of a handler. A stripe is only allocated once a thread mapped to it records
+// into it, so a handler that always runs on the same thread costs a single stripe.
+class HandlerRecorder
+{
+public:
+    HandlerRecorder() = default;
+    HandlerRecorder(const HandlerRecorder&) = delete;
+    HandlerRecorder& operator=(const HandlerRecorder&) = delete;
+
+    ~HandlerRecorder()
+    {
+        for (std::atomic<Stripe*>& stripe : m_stripes)
+        {
+            delete stripe.load();
+        }
+    }
+
+    void record(std::chrono::steady_clock::duration elapsed)
+    {
+        uint64_t nanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        Stripe& stripe = this->stripe(metricStripe());
+        stripe.invocations.fetch_add(1, std::memory_order_relaxed);
+        stripe.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        stripe.buckets[LatencyHistogram::bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Add the stripes up into metrics. Counts recorded concurrently may or may not be included.
+    void read(HandlerMetrics& metrics) const
+    {
+        for (const std::atomic<Stripe*>& stripeSlot : m_stripes)
+        {
+            const Stripe* stripe = stripeSlot.load(std::memory_order_acquire);
+            if (stripe == nullptr)
+            {
+                continue;
+            }
+            metrics.invocations += stripe->invocations.load(std::memory_order_relaxed);
+            metrics.totalNanoseconds += stripe->totalNanoseconds.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < LatencyHistogram::BucketCount; ++i)
+            {
+                metrics.latency.buckets[i] += stripe->buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Stripe
+    {
+        std::atomic<uint64_t> invocations{0};
+        std::atomic<uint64_t> totalNanoseconds{0};
+        std::atomic<uint64_t> buckets[LatencyHistogram::BucketCount] = {};
+    };
+
+    Stripe& stripe(size_t index)
+    {
+        Stripe* stripe = m_stripes[index].load(std::memory_order_acquire);
+        if (stripe == nullptr)
+        {
+            Stripe* created = new Stripe();
+            if (m_stripes[index].compare_exchange_strong(stripe, created, std::memory_order_acq_rel))
+            {
+                stripe = created;
+            }
+            else
+            {
+                delete created;
+            }
+        }
+        return *stripe;
+    }
+
+    std::atomic<Stripe*> m_stripes[MetricStripes] = {};
+};
+
+#endif // EVENTMETRICS_H
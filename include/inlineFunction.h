@@ -0,0 +1,222 @@
+#ifndef INLINEFUNCTION_H
+#define INLINEFUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// InlineFunction is a fixed-capacity alternative to std::function. Callables whose size fits within the compile-time Capacity
+// (and that can be moved without throwing) are stored directly inside the object, so constructing, copying, moving and calling
+// an InlineFunction never touches the heap. Callables that are too large for the buffer are still accepted, but fall back to
+// being allocated on the heap (with only a pointer to them kept in the buffer).
+// Like std::function, calling an empty InlineFunction is not allowed; check it with operator bool first.
+template <typename Signature, size_t Capacity> class InlineFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+    static_assert(Capacity >= sizeof(void*), "InlineFunction needs room for at least a pointer to a heap-allocated callable.");
+
+private:
+    // Type-erased operations for the callable currently held in m_storage.
+    struct Operations
+    {
+        R(*invoke)(void* storage, Args&&... params);
+        void(*copy)(void* destination, const void* source);
+        void(*move)(void* destination, void* source) noexcept;
+        void(*destroy)(void* storage) noexcept;
+    };
+
+    // Operations for callables stored inside the buffer.
+    template <typename Callable> struct InlineOperations
+    {
+        static R invoke(void* storage, Args&&... params)
+        {
+            return (*static_cast<Callable*>(storage))(std::forward<Args>(params)...);
+        }
+
+        static void copy(void* destination, const void* source)
+        {
+            new (destination) Callable(*static_cast<const Callable*>(source));
+        }
+
+        static void move(void* destination, void* source) noexcept
+        {
+            new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+            static_cast<Callable*>(source)->~Callable();
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            static_cast<Callable*>(storage)->~Callable();
+        }
+
+        static constexpr Operations operations = { &invoke, &copy, &move, &destroy };
+    };
+
+    // Operations for oversized callables, for which the buffer only holds a pointer to a heap-allocated copy.
+    template <typename Callable> struct HeapOperations
+    {
+        static R invoke(void* storage, Args&&... params)
+        {
+            return (**static_cast<Callable**>(storage))(std::forward<Args>(params)...);
+        }
+
+        static void copy(void* destination, const void* source)
+        {
+            new (destination) Callable*(new Callable(**static_cast<Callable* const*>(source)));
+        }
+
+        static void move(void* destination, void* source) noexcept
+        {
+            new (destination) Callable*(*static_cast<Callable**>(source));
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            delete *static_cast<Callable**>(storage);
+        }
+
+        static constexpr Operations operations = { &invoke, &copy, &move, &destroy };
+    };
+
+    template <typename Callable> static bool isNull(const Callable& callable)
+    {
+        if constexpr (std::is_pointer_v<Callable> || std::is_member_pointer_v<Callable>)
+        {
+            return callable == nullptr;
+        }
+        else if constexpr (std::is_same_v<Callable, std::function<R(Args...)>>)
+        {
+            return !callable;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+public:
+    // Whether a callable of the given type is stored inside the buffer (true) or falls back to the heap (false).
+    template <typename Callable> static constexpr bool storedInline()
+    {
+        return sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    InlineFunction() noexcept
+        : m_operations(nullptr)
+    {}
+
+    InlineFunction(std::nullptr_t) noexcept
+        : m_operations(nullptr)
+    {}
+
+    // Wrap any callable that can be invoked with Args... . Null function pointers and empty std::functions produce an empty InlineFunction.
+    template <typename F, typename Callable = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<Callable, InlineFunction> && std::is_invocable_r_v<R, Callable&, Args...>>>
+    InlineFunction(F&& func)
+        : m_operations(nullptr)
+    {
+        if (isNull(func))
+        {
+            return;
+        }
+
+        if constexpr (storedInline<Callable>())
+        {
+            new (m_storage) Callable(std::forward<F>(func));
+            m_operations = &InlineOperations<Callable>::operations;
+        }
+        else
+        {
+            new (m_storage) Callable*(new Callable(std::forward<F>(func)));
+            m_operations = &HeapOperations<Callable>::operations;
+        }
+    }
+
+    // Copy constructor. The operations are only taken over once the copy succeeded, so that a callable whose copy constructor
+    // throws never leaves this InlineFunction pointing at storage that holds nothing.
+    InlineFunction(const InlineFunction& src)
+        : m_operations(nullptr)
+    {
+        if (src.m_operations)
+        {
+            src.m_operations->copy(m_storage, src.m_storage);
+            m_operations = src.m_operations;
+        }
+    }
+
+    // Move constructor.
+    InlineFunction(InlineFunction&& src) noexcept
+        : m_operations(src.m_operations)
+    {
+        if (m_operations)
+        {
+            m_operations->move(m_storage, src.m_storage);
+            src.m_operations = nullptr;
+        }
+    }
+
+    ~InlineFunction()
+    {
+        reset();
+    }
+
+    // Copy assignment operator.
+    InlineFunction& operator=(const InlineFunction& src)
+    {
+        if (&src == this) return *this;
+        reset();
+        if (src.m_operations)
+        {
+            src.m_operations->copy(m_storage, src.m_storage);
+            m_operations = src.m_operations;
+        }
+
+        return *this;
+    }
+
+    // Move assignment operator.
+    InlineFunction& operator=(InlineFunction&& src) noexcept
+    {
+        if (&src == this) return *this;
+        reset();
+        if (src.m_operations)
+        {
+            src.m_operations->move(m_storage, src.m_storage);
+            m_operations = src.m_operations;
+            src.m_operations = nullptr;
+        }
+
+        return *this;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_operations != nullptr;
+    }
+
+    // Function call operator. As with std::function, the wrapped callable is invoked as non-const even through a const InlineFunction.
+    R operator()(Args... params) const
+    {
+        return m_operations->invoke(m_storage, std::forward<Args>(params)...);
+    }
+
+    void reset() noexcept
+    {
+        if (m_operations)
+        {
+            m_operations->destroy(m_storage);
+            m_operations = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) mutable unsigned char m_storage[Capacity];
+    const Operations* m_operations;
+};
+
+#endif // INLINEFUNCTION_H
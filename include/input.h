@@ -6,13 +6,18 @@
 // the input plugin has separate keyboard-specific and mouse-specific events, and also has the option of being called either
 // on its own thread, or by pushing onto/subscribing to a Runner.
 //#define EVENT_SYNC_KEYBOARD_I // Calls each handler in the input_keyboard event one-at-a-time, in sequence.
-#define EVENT_ASYNC_KEYBOARD_I // Spawns new threads for each handler in input_keyboard to be executed in.
+#define EVENT_ASYNC_KEYBOARD_I // Runs the handlers in input_keyboard concurrently on the shared worker pool.
 //#define EVENT_MULTI_KEYBOARD_I // Utilize the input_keyboard event in multiple different threads.
+//#define EVENT_POST_KEYBOARD_I // Post to the input_keyboard event; its handlers run when the posted Events are next drained.
+//#define EVENT_DISPATCH_KEYBOARD_I // Dispatch input_keyboard to the shared worker pool without waiting; its handlers overlap the rest of the input loop.
 #define DIRECT_KEYBOARD_I // Call each InputDesc registered to the loaded input plugin containing a keyboard-bound function for updating.
 
 //#define EVENT_SYNC_MOUSE_I // Calls each handler in the input_mouse event one-at-a-time, in sequence.
-#define EVENT_ASYNC_MOUSE_I // Spawns new threads for each handler in input_mouse to be executed in.
+#define EVENT_ASYNC_MOUSE_I // Runs the handlers in input_mouse concurrently on the shared worker pool.
 //#define EVENT_MULTI_MOUSE_I // Utilize the input_mouse event in multiple different threads.
+//#define EVENT_POST_MOUSE_I // Post to the input_mouse event; its handlers run when the posted Events are next drained.
+//#define EVENT_DISPATCH_MOUSE_I // Dispatch input_mouse to the shared worker pool without waiting; its handlers overlap the rest of the input loop.
+//#define CONFLATE_MOUSE_I // With EVENT_POST_MOUSE_I, only keep the latest undelivered input_mouse call, so bursts of mouse motion don't pile up.
 #define DIRECT_MOUSE_I // Call each InputDesc registered to the loaded input plugin containing a mouse-bound function for updating.
 
 #define EVENT_RUNNER_I // Subscribe the input plugin to a runner event if Input is not being updated in its own thread.
@@ -0,0 +1,143 @@
+#ifndef MPSCRINGBUFFER_H
+#define MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// MpscRingBuffer is a bounded, lock-free queue for any number of producer threads and a single consumer thread. Every cell of the
+// ring carries a sequence number that tells producers and the consumer whose turn it is to use the cell: a producer claims a cell
+// by advancing the shared tail with a CAS, constructs its value in place and then publishes it by bumping the cell's sequence;
+// the consumer only reads a cell once its sequence says it has been published. Pushing onto a full queue fails instead of
+// blocking or allocating, so the caller decides what to do with the overflow.
+// The capacity is rounded up to a power of two.
+template <typename T> class MpscRingBuffer
+{
+public:
+    explicit MpscRingBuffer(size_t capacity)
+        : m_mask(roundUpToPowerOfTwo(capacity) - 1), m_cells(new Cell[m_mask + 1]), m_head(0), m_tail(0)
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpscRingBuffer()
+    {
+        while (consume([](T&) {}))
+        {
+        }
+        delete[] m_cells;
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    size_t capacity() const
+    {
+        return m_mask + 1;
+    }
+
+    // Approximate number of queued values (exact when no producer is in the middle of a push).
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+    }
+
+    // Enqueue a value. Safe to call from any number of threads at once. Returns false if the queue is full.
+    template <typename... ValueArgs> bool push(ValueArgs&&... valueArgs)
+    {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &m_cells[position & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0)
+            {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) T(std::forward<ValueArgs>(valueArgs)...);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Dequeue the oldest published value. Must only be called by one thread at a time. Returns false if the queue is empty.
+    bool pop(T& value)
+    {
+        return consume([&value](T& stored) { value = std::move(stored); });
+    }
+
+    // Hand the oldest published value to the given function (in place, without moving it out of the queue) and then dequeue it.
+    // The value is dequeued even if func throws, so a bad value can't wedge the queue. Must only be called by one thread at a
+    // time. Returns false if the queue is empty.
+    template <typename F> bool consume(F&& func)
+    {
+        size_t position = m_head.load(std::memory_order_relaxed);
+        Cell* cell = &m_cells[position & m_mask];
+        if (cell->sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return false;
+        }
+
+        struct Release
+        {
+            ~Release()
+            {
+                stored->~T();
+                cell->sequence.store(position + queue->m_mask + 1, std::memory_order_release);
+                queue->m_head.store(position + 1, std::memory_order_relaxed);
+            }
+
+            MpscRingBuffer* queue;
+            Cell* cell;
+            T* stored;
+            size_t position;
+        };
+        Release release{ this, cell, std::launder(reinterpret_cast<T*>(cell->storage)), position };
+        func(*release.stored);
+        return true;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t m_mask;
+    Cell* const m_cells;
+    // The consumer's and the producers' positions are kept on separate cache lines so that they don't false-share.
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
+#endif // MPSCRINGBUFFER_H
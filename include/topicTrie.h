@@ -0,0 +1,153 @@
+#ifndef TOPICTRIE_H
+#define TOPICTRIE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// TopicTrie maps dotted topic patterns (e.g. "input.keyboard.pressed") to ids, and finds the ids of every pattern matching a
+// given topic. Patterns are split on '.' into segments, each of which is either a literal that has to match the topic's segment
+// exactly, '*', which matches any single segment, or '#', which matches any number of segments (including none). For example,
+// "input.*" matches "input.keyboard" but not "input.keyboard.pressed", while "input.#" matches both (and "input" itself).
+// Matching walks the trie one topic segment at a time, so its cost depends on the topic's depth and the wildcards along the way,
+// not on the total number of patterns.
+class TopicTrie
+{
+public:
+    // Whether a pattern contains any wildcard segment.
+    static bool isPattern(std::string_view pattern)
+    {
+        for (std::string_view segment : split(pattern))
+        {
+            if (segment == "*" || segment == "#")
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(std::string_view pattern, size_t id)
+    {
+        Node* node = &m_root;
+        for (std::string_view segment : split(pattern))
+        {
+            std::unique_ptr<Node>& child = node->children[std::string(segment)];
+            if (child == nullptr)
+            {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+        }
+        node->ids.push_back(id);
+    }
+
+    // Remove an id previously inserted under the given pattern, pruning the nodes left empty. Returns false if it wasn't there.
+    bool erase(std::string_view pattern, size_t id)
+    {
+        std::vector<std::string_view> segments = split(pattern);
+        return erase(m_root, segments, 0, id);
+    }
+
+    // The ids of every pattern matching the topic, in ascending order and without duplicates.
+    std::vector<size_t> match(std::string_view topic) const
+    {
+        std::vector<std::string_view> segments = split(topic);
+        std::vector<size_t> ids;
+        match(m_root, segments, 0, ids);
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+
+    bool empty() const
+    {
+        return m_root.children.empty() && m_root.ids.empty();
+    }
+
+private:
+    struct Node
+    {
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> children;
+        std::vector<size_t> ids;
+    };
+
+    static std::vector<std::string_view> split(std::string_view topic)
+    {
+        std::vector<std::string_view> segments;
+        size_t start = 0;
+        while (true)
+        {
+            size_t end = topic.find('.', start);
+            segments.push_back(topic.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+            if (end == std::string_view::npos)
+            {
+                return segments;
+            }
+            start = end + 1;
+        }
+    }
+
+    static void match(const Node& node, const std::vector<std::string_view>& segments, size_t depth, std::vector<size_t>& ids)
+    {
+        // '#' can swallow any number of the remaining segments, including none of them.
+        auto multi = node.children.find("#");
+        if (multi != node.children.end())
+        {
+            for (size_t skip = depth; skip <= segments.size(); ++skip)
+            {
+                match(*multi->second, segments, skip, ids);
+            }
+        }
+
+        if (depth == segments.size())
+        {
+            ids.insert(ids.end(), node.ids.begin(), node.ids.end());
+            return;
+        }
+
+        auto literal = node.children.find(segments[depth]);
+        if (literal != node.children.end())
+        {
+            match(*literal->second, segments, depth + 1, ids);
+        }
+        auto single = node.children.find("*");
+        if (single != node.children.end())
+        {
+            match(*single->second, segments, depth + 1, ids);
+        }
+    }
+
+    static bool erase(Node& node, const std::vector<std::string_view>& segments, size_t depth, size_t id)
+    {
+        if (depth == segments.size())
+        {
+            auto it = std::find(node.ids.begin(), node.ids.end(), id);
+            if (it == node.ids.end())
+            {
+                return false;
+            }
+            node.ids.erase(it);
+            return true;
+        }
+
+        auto child = node.children.find(segments[depth]);
+        if (child == node.children.end() || !erase(*child->second, segments, depth + 1, id))
+        {
+            return false;
+        }
+        if (child->second->children.empty() && child->second->ids.empty())
+        {
+            node.children.erase(child);
+        }
+        return true;
+    }
+
+    Node m_root;
+};
+
+#endif // TOPICTRIE_H
@@ -6,7 +6,14 @@
 
 #include "stdafx.h" // this header needs to come first
 #include <mutex>
+#include <shared_mutex>
+#include <iostream>
 #include "containerImpl.h"
+#include "workerPool.h"
+#include "postedQueues.h"
+#include "executors.h"
+#include "watchdog.h"
+#include <set>
 #include "pluginManager.h"
 
 // Share this plugin (.dll or .so) across the entire application.
@@ -22,13 +29,28 @@ std::map<std::string, HMODULE> g_handles;
 #elif __linux__
 std::map<std::string, void*> g_handles;
 #endif
-std::map<std::string, size_t> g_eventsRef;
-std::map<std::string, void*> g_events;
+std::unordered_map<EventKey::Hash, size_t> g_eventsRef;
+std::unordered_map<EventKey::Hash, void*> g_events;
+std::unordered_map<EventKey::Hash, std::string> g_eventNames;
 std::map<std::string, size_t> g_eventStreamsRef;
 std::map<std::string, void*> g_eventStreams;
+WorkerPool g_workerPool;
+PostedQueues g_postedQueues;
+Executors g_executors;
+std::map<std::string, std::string> g_eventAffinities;
+Watchdog g_watchdog;
+std::set<std::string> g_pluginNames;
+std::unordered_map<EventKey::Hash, std::function<EventMetrics()>> g_metricsSources;
 #pragma data_seg()
 
+thread_local const char* t_currentPlugin = nullptr;
+
 std::recursive_mutex m_lock;
+// The Event map is looked up on every name-based call, post and subscription, so it has a reader lock of its own rather than
+// going through m_lock.
+std::shared_mutex m_eventsLock;
+// Metrics sources are read under a shared lock of their own, so that reading metrics doesn't hold up the rest of the container.
+std::shared_mutex m_metricsLock;
 
 size_t ContainerImpl::getExeDir()
 {
@@ -153,55 +175,96 @@ void ContainerImpl::eraseHandle(std::map<std::string, void*>::iterator it)
 #endif
 
 // Reference counter for events.
-std::map<std::string, size_t> &ContainerImpl::getEventRefCount()
+std::unordered_map<EventKey::Hash, size_t> &ContainerImpl::getEventRefCount()
 {
     return g_eventsRef;
 }
 
-void ContainerImpl::addEventRefCount(std::string name)
+bool ContainerImpl::addEventRefCount(const EventKey& key)
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
-    if (g_eventsRef.find(name) != g_eventsRef.end())
     {
-        ++g_eventsRef.at(name);
+        std::shared_lock<std::shared_mutex> eventsLock(m_eventsLock);
+        auto name = g_eventNames.find(key.hash());
+        if (name != g_eventNames.end() && name->second != key.name())
+        {
+            return false;
+        }
+    }
+
+    if (g_eventsRef.find(key.hash()) != g_eventsRef.end())
+    {
+        ++g_eventsRef.at(key.hash());
     }
     else
     {
-        g_eventsRef.insert(std::pair<std::string, int>(name, 1));
+        g_eventsRef.insert(std::pair<EventKey::Hash, size_t>(key.hash(), 1));
     }
+    return true;
 }
 
-void ContainerImpl::subtractEventRefCount(std::string name)
+void ContainerImpl::subtractEventRefCount(const EventKey& key)
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
-    if (g_eventsRef.find(name) != g_eventsRef.end())
+    if (g_eventsRef.find(key.hash()) != g_eventsRef.end())
     {
-        --g_eventsRef.at(name);
+        --g_eventsRef.at(key.hash());
     }
 }
 
-void ContainerImpl::eraseEventRefCount(std::string name)
+void ContainerImpl::eraseEventRefCount(const EventKey& key)
 {
     std::lock_guard<std::recursive_mutex> lock(m_lock);
-    g_eventsRef.erase(name);
+    g_eventsRef.erase(key.hash());
 }
 
-// Store void pointers to Events.
-std::map<std::string, void*>& ContainerImpl::getEvents()
+// Store void pointers to Events, along with the names they were registered under (used to detect hash collisions).
+std::unordered_map<EventKey::Hash, void*>& ContainerImpl::getEvents()
 {
     return g_events;
 }
 
-void ContainerImpl::addEvent(std::string name, void* ptr_event)
+void* ContainerImpl::getEvent(const EventKey& key)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_lock);
-    g_events[name] = ptr_event;
+    std::shared_lock<std::shared_mutex> lock(m_eventsLock);
+    auto it = g_events.find(key.hash());
+    if (it == g_events.end())
+    {
+        return nullptr;
+    }
+
+    // create() refuses names whose hash collides with an existing Event's, but looking up a name that was never created can
+    // still land on another Event. Debug builds compare the names to catch that.
+    #ifndef NDEBUG
+    auto name = g_eventNames.find(key.hash());
+    if (name != g_eventNames.end() && name->second != key.name())
+    {
+        std::cout << "ERROR: Event name " << key.name() << " collides with the key of Event " << name->second << "; unable to look it up" << std::endl;
+        return nullptr;
+    }
+    #endif
+    return it->second;
 }
 
-void ContainerImpl::eraseEvent(std::string name)
+bool ContainerImpl::addEvent(const EventKey& key, void* ptr_event)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_lock);
-    g_events.erase(name);
+    std::unique_lock<std::shared_mutex> lock(m_eventsLock);
+    auto name = g_eventNames.find(key.hash());
+    if (name != g_eventNames.end() && name->second != key.name())
+    {
+        return false;
+    }
+
+    g_eventNames[key.hash()] = std::string(key.name());
+    g_events[key.hash()] = ptr_event;
+    return true;
+}
+
+void ContainerImpl::eraseEvent(const EventKey& key)
+{
+    std::unique_lock<std::shared_mutex> lock(m_eventsLock);
+    g_events.erase(key.hash());
+    g_eventNames.erase(key.hash());
 }
 
 std::map<std::string, size_t>& ContainerImpl::getEventStreamRefCount()
@@ -254,6 +317,152 @@ void ContainerImpl::eraseEventStream(std::string type)
     g_eventStreams.erase(type);
 }
 
+// Work-stealing worker pool shared by every plugin.
+size_t ContainerImpl::getWorkerCount()
+{
+    return g_workerPool.getWorkerCount();
+}
+
+void ContainerImpl::setWorkerCount(size_t count)
+{
+    g_workerPool.setWorkerCount(count);
+}
+
+void ContainerImpl::submitTask(std::function<void()> task)
+{
+    g_workerPool.submit(std::move(task));
+}
+
+void ContainerImpl::submitLongRunningTask(std::function<void()> task)
+{
+    g_workerPool.submitLongRunning(std::move(task));
+}
+
+bool ContainerImpl::runPendingTask()
+{
+    return g_workerPool.runPendingTask();
+}
+
+// Deferred queues of posted Events.
+void ContainerImpl::addPostedQueue(void* owner, std::function<size_t()> drain)
+{
+    g_postedQueues.add(owner, std::move(drain));
+}
+
+void ContainerImpl::erasePostedQueue(void* owner)
+{
+    g_postedQueues.erase(owner);
+}
+
+size_t ContainerImpl::drainPostedQueues()
+{
+    return g_postedQueues.drainAll();
+}
+
+void ContainerImpl::notifyPosted()
+{
+    g_postedQueues.notify();
+}
+
+void ContainerImpl::setPostedDispatcher(bool enabled)
+{
+    g_postedQueues.setDispatcher(enabled);
+}
+
+// Named executors, and the executor affinities given to Events in the configuration file.
+size_t ContainerImpl::getExecutor(const std::string& name, int core)
+{
+    return g_executors.get(name, core);
+}
+
+void ContainerImpl::submitToExecutor(size_t executor, std::function<void()> task)
+{
+    g_executors.submit(executor, std::move(task));
+}
+
+size_t ContainerImpl::currentExecutor()
+{
+    return g_executors.current();
+}
+
+void ContainerImpl::setEventAffinity(const std::string& eventName, const std::string& affinity)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lock);
+    g_eventAffinities[eventName] = affinity;
+}
+
+std::string ContainerImpl::getEventAffinity(const std::string& eventName)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_lock);
+    auto it = g_eventAffinities.find(eventName);
+    return it != g_eventAffinities.end() ? it->second : std::string();
+}
+
+// Deadline watchdog, and the plugin each thread is currently running code for.
+size_t ContainerImpl::watchDeadline(std::chrono::steady_clock::time_point deadline, std::function<void()> onOverrun)
+{
+    return g_watchdog.watch(deadline, std::move(onOverrun));
+}
+
+void ContainerImpl::clearDeadline(size_t ticket)
+{
+    g_watchdog.clear(ticket);
+}
+
+void ContainerImpl::setCurrentPlugin(const std::string& pluginName)
+{
+    if (pluginName.empty())
+    {
+        t_currentPlugin = nullptr;
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(m_lock);
+    t_currentPlugin = g_pluginNames.insert(pluginName).first->c_str();
+}
+
+const char* ContainerImpl::getCurrentPlugin()
+{
+    return t_currentPlugin;
+}
+
+// Event metrics. The sources are called under a shared m_metricsLock, so that reads run concurrently while an Event erasing
+// its source (right before it's deleted) waits for any read in progress.
+void ContainerImpl::addMetricsSource(const EventKey& key, std::function<EventMetrics()> read)
+{
+    std::unique_lock<std::shared_mutex> lock(m_metricsLock);
+    g_metricsSources[key.hash()] = std::move(read);
+}
+
+void ContainerImpl::eraseMetricsSource(const EventKey& key)
+{
+    std::unique_lock<std::shared_mutex> lock(m_metricsLock);
+    g_metricsSources.erase(key.hash());
+}
+
+bool ContainerImpl::getEventMetrics(const EventKey& key, EventMetrics& metrics)
+{
+    std::shared_lock<std::shared_mutex> lock(m_metricsLock);
+    auto source = g_metricsSources.find(key.hash());
+    if (source == g_metricsSources.end())
+    {
+        return false;
+    }
+    metrics = source->second();
+    return true;
+}
+
+std::vector<EventMetrics> ContainerImpl::getAllEventMetrics()
+{
+    std::shared_lock<std::shared_mutex> lock(m_metricsLock);
+    std::vector<EventMetrics> metrics;
+    metrics.reserve(g_metricsSources.size());
+    for (auto& source : g_metricsSources)
+    {
+        metrics.push_back(source.second());
+    }
+    return metrics;
+}
+
 // Create a container instance.
 extern "C" CONTAINER ContainerImpl* Create()
 {
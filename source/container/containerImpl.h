@@ -45,13 +45,14 @@ public:
     void eraseHandle(std::map<std::string, void*>::iterator it);
     #endif
 
-    std::map<std::string, size_t>& getEventRefCount();
-    void addEventRefCount(std::string name);
-    void subtractEventRefCount(std::string name);
-    void eraseEventRefCount(std::string name);
-    std::map<std::string, void*>& getEvents();
-    void addEvent(std::string name, void* ptr_event);
-    void eraseEvent(std::string name);
+    std::unordered_map<EventKey::Hash, size_t>& getEventRefCount();
+    bool addEventRefCount(const EventKey& key);
+    void subtractEventRefCount(const EventKey& key);
+    void eraseEventRefCount(const EventKey& key);
+    std::unordered_map<EventKey::Hash, void*>& getEvents();
+    void* getEvent(const EventKey& key);
+    bool addEvent(const EventKey& key, void* ptr_event);
+    void eraseEvent(const EventKey& key);
 
     std::map<std::string, size_t>& getEventStreamRefCount();
     void addEventStreamRefCount(std::string type);
@@ -60,6 +61,34 @@ public:
     std::map<std::string, void*>& getEventStreams();
     void addEventStream(std::string type, void* ptr_eventStream);
     void eraseEventStream(std::string type);
+
+    size_t getWorkerCount();
+    void setWorkerCount(size_t count);
+    void submitTask(std::function<void()> task);
+    void submitLongRunningTask(std::function<void()> task);
+    bool runPendingTask();
+
+    void addPostedQueue(void* owner, std::function<size_t()> drain);
+    void erasePostedQueue(void* owner);
+    size_t drainPostedQueues();
+    void notifyPosted();
+    void setPostedDispatcher(bool enabled);
+
+    size_t getExecutor(const std::string& name, int core);
+    void submitToExecutor(size_t executor, std::function<void()> task);
+    size_t currentExecutor();
+    void setEventAffinity(const std::string& eventName, const std::string& affinity);
+    std::string getEventAffinity(const std::string& eventName);
+
+    size_t watchDeadline(std::chrono::steady_clock::time_point deadline, std::function<void()> onOverrun);
+    void clearDeadline(size_t ticket);
+    void setCurrentPlugin(const std::string& pluginName);
+    const char* getCurrentPlugin();
+
+    void addMetricsSource(const EventKey& key, std::function<EventMetrics()> read);
+    void eraseMetricsSource(const EventKey& key);
+    bool getEventMetrics(const EventKey& key, EventMetrics& metrics);
+    std::vector<EventMetrics> getAllEventMetrics();
 };
 
 extern "C" CONTAINER ContainerImpl* Create();
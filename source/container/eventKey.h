@@ -0,0 +1,58 @@
+#ifndef EVENTKEY_H
+#define EVENTKEY_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// EventKey identifies an Event by the 64-bit FNV-1a hash of its name. The container stores Events by that hash, so looking an
+// Event up only involves comparing integers. Hashing is constexpr: declaring a key for a literal name, e.g.
+//     constexpr EventKey runnerKey("runner");
+// computes the hash at compile time, while keys built on the fly from strings (including the implicit conversions used by the
+// name-based EventStream functions) hash the name at runtime. The name itself is kept alongside the hash so that the container
+// can detect two different names that collide when an Event is registered.
+// An EventKey only refers to the name it was built from (it does not copy it), so it must not outlive that string.
+class EventKey
+{
+public:
+    typedef uint64_t Hash;
+
+    constexpr EventKey(const char* name)
+        : m_name(name), m_hash(fnv1a(m_name))
+    {}
+
+    constexpr EventKey(std::string_view name)
+        : m_name(name), m_hash(fnv1a(m_name))
+    {}
+
+    EventKey(const std::string& name)
+        : m_name(name), m_hash(fnv1a(m_name))
+    {}
+
+    constexpr Hash hash() const
+    {
+        return m_hash;
+    }
+
+    constexpr std::string_view name() const
+    {
+        return m_name;
+    }
+
+    static constexpr Hash fnv1a(std::string_view name)
+    {
+        Hash hash = 14695981039346656037ull;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+private:
+    std::string_view m_name;
+    Hash m_hash;
+};
+
+#endif // EVENTKEY_H
@@ -0,0 +1,161 @@
+// Implementation of the named (and optionally pinned) executors kept by the container.
+
+#include "stdafx.h" // this header needs to come first
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include "executors.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+    // Identifies the executors instance (and the executor inside it) that the current thread belongs to, if any.
+    thread_local Executors* t_executors = nullptr;
+    thread_local size_t t_executor = Executors::None;
+}
+
+Executors::Executors()
+    : m_count(0)
+{}
+
+Executors::~Executors()
+{
+    size_t count = m_count.load();
+    for (size_t i = 0; i < count; ++i)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_executors[i]->lock);
+            m_executors[i]->stop = true;
+        }
+        m_executors[i]->condition.notify_one();
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_executors[i]->thread.joinable())
+        {
+            m_executors[i]->thread.join();
+        }
+    }
+}
+
+size_t Executors::get(const std::string& name, int core)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    size_t count = m_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_executors[i]->name == name)
+        {
+            if (core >= 0 && m_executors[i]->core != core)
+            {
+                std::cout << "Executor " << name << " is already running on core " << m_executors[i]->core << "; unable to move it to core " << core << std::endl;
+            }
+            return i;
+        }
+    }
+    if (count == MaxExecutors)
+    {
+        std::cout << "Too many executors; unable to start executor " << name << std::endl;
+        return None;
+    }
+
+    std::unique_ptr<Executor> executor = std::make_unique<Executor>();
+    executor->name = name;
+    executor->core = core;
+    m_executors[count] = std::move(executor);
+    m_executors[count]->thread = std::thread(&Executors::executorLoop, this, count);
+    if (core >= 0)
+    {
+        pin(m_executors[count]->thread, name, core);
+    }
+    m_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+void Executors::submit(size_t executor, std::function<void()> task)
+{
+    Executor& target = *m_executors[executor];
+    {
+        std::lock_guard<std::mutex> lock(target.lock);
+        target.tasks.push_back(std::move(task));
+    }
+    target.condition.notify_one();
+}
+
+size_t Executors::current()
+{
+    return t_executors == this ? t_executor : None;
+}
+
+// Run the executor's tasks in order until it's stopped, finishing whatever was queued before the stop.
+void Executors::executorLoop(size_t index)
+{
+    t_executors = this;
+    t_executor = index;
+
+    Executor& executor = *m_executors[index];
+    std::unique_lock<std::mutex> lock(executor.lock);
+    while (true)
+    {
+        executor.condition.wait(lock, [&executor] { return executor.stop || !executor.tasks.empty(); });
+        if (executor.tasks.empty())
+        {
+            break;
+        }
+
+        std::function<void()> task = std::move(executor.tasks.front());
+        executor.tasks.pop_front();
+        lock.unlock();
+        try
+        {
+            task();
+        }
+        catch (const std::exception& exception)
+        {
+            std::cout << "A task on executor " << executor.name << " threw an exception (" << exception.what() << "); unable to report it to its submitter" << std::endl;
+        }
+        catch (...)
+        {
+            std::cout << "A task on executor " << executor.name << " threw an exception; unable to report it to its submitter" << std::endl;
+        }
+        lock.lock();
+    }
+
+    t_executors = nullptr;
+    t_executor = None;
+}
+
+void Executors::pin(std::thread& thread, const std::string& name, int core)
+{
+    unsigned int cores = std::thread::hardware_concurrency();
+    if (cores > 0 && static_cast<unsigned int>(core) >= cores)
+    {
+        std::cout << "Core " << core << " doesn't exist; unable to pin executor " << name << " to it" << std::endl;
+        return;
+    }
+
+    // The executor runs unpinned if the OS refuses the affinity (e.g. the core is outside the process's allowed set).
+    #ifdef _WIN32
+    if (core >= int(sizeof(DWORD_PTR) * 8) || SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core) == 0)
+    {
+        std::cout << "Unable to pin executor " << name << " to core " << core << " (error " << GetLastError() << "); it runs unpinned" << std::endl;
+    }
+    #elif __linux__
+    int result = EINVAL;
+    if (core < CPU_SETSIZE)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        result = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpus);
+    }
+    if (result != 0)
+    {
+        std::cout << "Unable to pin executor " << name << " to core " << core << " (" << std::strerror(result) << "); it runs unpinned" << std::endl;
+    }
+    #endif
+}
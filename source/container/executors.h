@@ -0,0 +1,58 @@
+#ifndef EXECUTORS_H
+#define EXECUTORS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Executors keeps the named executors shared by all plugins: dedicated threads that each run the tasks submitted to them one
+// at a time and in submission order, optionally pinned to a CPU core. Unlike the worker pool, which hands a task to whichever
+// worker is free, an executor always runs its tasks on the same thread, so handlers with a lot of state (see Affinity in
+// event.h) keep finding it in that core's cache. A single instance lives inside the container; executors are started the
+// first time they're asked for and run until the container goes away.
+class Executors
+{
+public:
+    // Returned by current() on threads that aren't executors.
+    static constexpr size_t None = ~size_t(0);
+    // Executors are never removed, so their number is bounded to keep their lookup lock-free.
+    static constexpr size_t MaxExecutors = 64;
+
+    Executors();
+    ~Executors();
+
+    // Index of the executor with the given name, which is started if it doesn't exist yet. A core of 0 or more pins the new
+    // executor's thread to that core (if the OS refuses, that's reported and the executor runs unpinned); an executor that's
+    // already running keeps the core it was started with. Returns None if there is no room for another executor.
+    size_t get(const std::string& name, int core);
+    // Queue a task on an executor, identified by the index get() returned.
+    void submit(size_t executor, std::function<void()> task);
+    // Index of the executor the calling thread belongs to, or None.
+    size_t current();
+
+private:
+    struct Executor
+    {
+        std::string name;
+        int core;
+        std::thread thread;
+        std::mutex lock;
+        std::condition_variable condition;
+        std::deque<std::function<void()>> tasks;
+        bool stop = false;
+    };
+
+    void executorLoop(size_t index);
+    static void pin(std::thread& thread, const std::string& name, int core);
+
+    std::mutex m_lock;
+    std::unique_ptr<Executor> m_executors[MaxExecutors];
+    std::atomic<size_t> m_count;
+};
+
+#endif // EXECUTORS_H
@@ -0,0 +1,118 @@
+// Implementation of the registry of posted Event queues (and of their optional dispatcher thread) kept by the container.
+
+#include "stdafx.h" // this header needs to come first
+#include "postedQueues.h"
+
+PostedQueues::PostedQueues()
+    : m_dispatcherRunning(false), m_posted(false), m_stopDispatcher(false)
+{}
+
+PostedQueues::~PostedQueues()
+{
+    setDispatcher(false);
+}
+
+void PostedQueues::add(void* owner, std::function<size_t()> drain)
+{
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->owner = owner;
+    entry->drain = std::move(drain);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_entries.push_back(entry);
+}
+
+void PostedQueues::erase(void* owner)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if ((*it)->owner == owner)
+            {
+                entry = *it;
+                m_entries.erase(it);
+                break;
+            }
+        }
+    }
+
+    // A drainAll() that grabbed the entry before it was removed may still be about to call it, so wait for any in-flight
+    // drain to finish and make sure no later one runs.
+    if (entry)
+    {
+        std::lock_guard<std::mutex> lock(entry->lock);
+        entry->erased = true;
+    }
+}
+
+// The registry lock is only held while copying the list of entries (not while draining), so that handlers are free to post to
+// new Events, or to create/destroy Events, from within a drain.
+size_t PostedQueues::drainAll()
+{
+    std::vector<std::shared_ptr<Entry>> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        entries = m_entries;
+    }
+
+    size_t drained = 0;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        std::lock_guard<std::mutex> lock(entries[i]->lock);
+        if (!entries[i]->erased)
+        {
+            drained += entries[i]->drain();
+        }
+    }
+    return drained;
+}
+
+void PostedQueues::notify()
+{
+    if (m_dispatcherRunning.load(std::memory_order_relaxed) && !m_posted.exchange(true))
+    {
+        std::lock_guard<std::mutex> lock(m_dispatcherLock);
+        m_dispatcherCondition.notify_one();
+    }
+}
+
+void PostedQueues::setDispatcher(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_controlLock);
+    if (enabled && !m_dispatcher.joinable())
+    {
+        m_stopDispatcher = false;
+        m_dispatcherRunning = true;
+        m_dispatcher = std::thread(&PostedQueues::dispatcherLoop, this);
+    }
+    else if (!enabled && m_dispatcher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> dispatcherLock(m_dispatcherLock);
+            m_stopDispatcher = true;
+        }
+        m_dispatcherCondition.notify_one();
+        m_dispatcher.join();
+        m_dispatcherRunning = false;
+    }
+}
+
+// Drain whatever has been posted, then sleep until the next post. The posted flag is cleared before draining, so a post that
+// lands while the queues are being drained leaves the flag set and triggers another round instead of being missed.
+void PostedQueues::dispatcherLoop()
+{
+    while (true)
+    {
+        m_posted = false;
+        drainAll();
+
+        std::unique_lock<std::mutex> lock(m_dispatcherLock);
+        m_dispatcherCondition.wait(lock, [this] { return m_stopDispatcher || m_posted.load(); });
+        if (m_stopDispatcher)
+        {
+            break;
+        }
+    }
+}
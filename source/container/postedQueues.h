@@ -0,0 +1,55 @@
+#ifndef POSTEDQUEUES_H
+#define POSTEDQUEUES_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// PostedQueues keeps track of the deferred queues of every Event that has been posted to (see Event::post), so that they can
+// all be drained from one place: either in a phase of the runner's tick, or by a dedicated dispatcher thread that sleeps until
+// something gets posted. A single instance lives inside the container.
+class PostedQueues
+{
+public:
+    PostedQueues();
+    ~PostedQueues();
+
+    // Register the drain function of an Event's queue, identified by the queue's owner.
+    void add(void* owner, std::function<size_t()> drain);
+    // Unregister an owner's queue. Once this returns, its drain function is neither running nor going to be called again.
+    void erase(void* owner);
+    // Drain every registered queue on the calling thread. Returns the number of posted calls that were dispatched.
+    size_t drainAll();
+    // Called by producers after posting; wakes the dispatcher thread if it is running and asleep.
+    void notify();
+    // Start or stop the dedicated dispatcher thread.
+    void setDispatcher(bool enabled);
+
+private:
+    struct Entry
+    {
+        void* owner;
+        std::function<size_t()> drain;
+        std::mutex lock;
+        bool erased = false;
+    };
+
+    void dispatcherLoop();
+
+    std::mutex m_lock;
+    std::vector<std::shared_ptr<Entry>> m_entries;
+
+    std::mutex m_controlLock;
+    std::thread m_dispatcher;
+    std::mutex m_dispatcherLock;
+    std::condition_variable m_dispatcherCondition;
+    std::atomic<bool> m_dispatcherRunning;
+    std::atomic<bool> m_posted;
+    bool m_stopDispatcher;
+};
+
+#endif // POSTEDQUEUES_H
@@ -0,0 +1,116 @@
+#ifndef TASKEXECUTOR_H
+#define TASKEXECUTOR_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <map>
+#include <string>
+#include <iostream>
+
+#include "container.h"
+#ifdef _WIN32
+#include <Windows.h>
+#elif __linux__
+#include <dlfcn.h>
+#else
+#error define your compiler
+#endif
+
+// TaskExecutor gives plugins access to the work-stealing worker pool that lives in the container, so that every plugin
+// schedules its asynchronous work on the same threads instead of creating its own (and oversubscribing the cores).
+// It holds no state of its own; the size_t identifier is a hashed representation of the app's executable directory.
+class TaskExecutor
+{
+private:
+    static inline Container* m_container = nullptr;
+
+    // Load the container plugin, which owns the worker pool shared across all loaded plugins.
+    static void loadContainer(size_t identifier)
+    {
+        if (m_container == nullptr)
+        {
+            const char* appDir = reinterpret_cast<const char*>(identifier);
+            #ifdef _WIN32
+            std::string intermediateString = std::string(appDir) + "\\container.dll";
+            std::wstring containerPath = std::wstring(intermediateString.begin(), intermediateString.end());
+            LPCWSTR cp = containerPath.c_str();
+            HMODULE containerHandle = LoadLibrary(cp);
+            typedef Container* (*fnCreateContainer)();
+            fnCreateContainer createContainer = (fnCreateContainer)GetProcAddress(containerHandle, "Create");
+            #elif __linux__
+            std::string containerPath = std::string(appDir) + "/container.so";
+            void* containerHandle = dlopen(containerPath.c_str(), 3);
+            typedef Container* (*fnCreateContainer)();
+            fnCreateContainer createContainer = (fnCreateContainer)dlsym(containerHandle, (char*)("Create"));
+            #endif
+            m_container = createContainer();
+        }
+    }
+
+    TaskExecutor() {}
+
+    // Wrap a task so that its completion (or exception) is reported through the returned future.
+    static std::function<void()> withPromise(std::function<void()> task, std::future<void>& future)
+    {
+        std::shared_ptr<std::promise<void>> promise = std::make_shared<std::promise<void>>();
+        future = promise->get_future();
+        return [task, promise]()
+        {
+            try
+            {
+                task();
+                promise->set_value();
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+        };
+    }
+
+public:
+    static TaskExecutor* Instance(size_t identifier)
+    {
+        static TaskExecutor instance;
+        loadContainer(identifier);
+        return &instance;
+    }
+
+    // Number of worker threads in the shared pool.
+    size_t getWorkerCount()
+    {
+        return m_container->getWorkerCount();
+    }
+
+    // Queue a short task on the shared pool.
+    void submit(std::function<void()> task)
+    {
+        m_container->submitTask(std::move(task));
+    }
+
+    // Queue a short task on the shared pool; the returned future becomes ready once the task has finished.
+    std::future<void> async(std::function<void()> task)
+    {
+        std::future<void> future;
+        m_container->submitTask(withPromise(std::move(task), future));
+        return future;
+    }
+
+    // Run a long-lived task (e.g. a plugin's update loop) on a thread managed by the pool, without taking a worker out of
+    // rotation. The returned future becomes ready once the task returns.
+    std::future<void> asyncLongRunning(std::function<void()> task)
+    {
+        std::future<void> future;
+        m_container->submitLongRunningTask(withPromise(std::move(task), future));
+        return future;
+    }
+
+    // Run one pending task on the calling thread, if there is one.
+    bool runPendingTask()
+    {
+        return m_container->runPendingTask();
+    }
+};
+
+#endif // TASKEXECUTOR_H
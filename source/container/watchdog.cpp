@@ -0,0 +1,100 @@
+// Implementation of the deadline watchdog kept by the container.
+
+#include "stdafx.h" // this header needs to come first
+#include "watchdog.h"
+
+// Tickets start at 1, so that 0 can stand for "no ticket" (both here, in m_running, and for the callers).
+Watchdog::Watchdog()
+    : m_nextTicket(1), m_running(0), m_stop(false)
+{}
+
+Watchdog::~Watchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+size_t Watchdog::watch(std::chrono::steady_clock::time_point deadline, std::function<void()> onOverrun)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    size_t ticket = m_nextTicket++;
+    m_watches.emplace(ticket, Watch{deadline, std::move(onOverrun)});
+    bool earliest = m_deadlines.empty() || deadline < m_deadlines.begin()->first;
+    m_deadlines.emplace(deadline, ticket);
+
+    if (!m_thread.joinable())
+    {
+        m_thread = std::thread(&Watchdog::watchdogLoop, this);
+    }
+    else if (earliest)
+    {
+        m_condition.notify_all();
+    }
+    return ticket;
+}
+
+void Watchdog::clear(size_t ticket)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    auto watch = m_watches.find(ticket);
+    if (watch != m_watches.end())
+    {
+        auto range = m_deadlines.equal_range(watch->second.deadline);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == ticket)
+            {
+                m_deadlines.erase(it);
+                break;
+            }
+        }
+        m_watches.erase(watch);
+        return;
+    }
+
+    // The deadline has already passed: wait for its function to return, if it's running.
+    m_condition.wait(lock, [this, ticket] { return m_running != ticket; });
+}
+
+// Sleep until the earliest deadline, then run its function without holding the lock, so that new deadlines can be set (and
+// others cleared) in the meantime.
+void Watchdog::watchdogLoop()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (!m_stop)
+    {
+        if (m_deadlines.empty())
+        {
+            m_condition.wait(lock);
+            continue;
+        }
+
+        auto earliest = m_deadlines.begin();
+        if (std::chrono::steady_clock::now() < earliest->first)
+        {
+            m_condition.wait_until(lock, earliest->first);
+            continue;
+        }
+
+        size_t ticket = earliest->second;
+        m_deadlines.erase(earliest);
+        auto watch = m_watches.find(ticket);
+        std::function<void()> onOverrun = std::move(watch->second.onOverrun);
+        m_watches.erase(watch);
+        m_running = ticket;
+
+        lock.unlock();
+        onOverrun();
+        lock.lock();
+
+        m_running = 0;
+        m_condition.notify_all();
+    }
+}
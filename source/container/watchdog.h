@@ -0,0 +1,46 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+// Watchdog calls a function when a deadline passes, unless the deadline is cleared first. Events use it to flag handlers that
+// overrun the deadline of their dispatch (see EventStream::setDeadline), which is why clearing a deadline also waits for its
+// function to return if it's running: the function can safely look at state that's freed right after the deadline is cleared.
+// A single instance lives inside the container; its thread is started with the first deadline, and sleeps until the earliest one.
+class Watchdog
+{
+public:
+    Watchdog();
+    ~Watchdog();
+
+    // Call onOverrun on the watchdog's thread once the deadline passes. Returns a ticket for clear().
+    size_t watch(std::chrono::steady_clock::time_point deadline, std::function<void()> onOverrun);
+    // Drop a deadline. Once this returns, its function is neither running nor going to be called.
+    void clear(size_t ticket);
+
+private:
+    struct Watch
+    {
+        std::chrono::steady_clock::time_point deadline;
+        std::function<void()> onOverrun;
+    };
+
+    void watchdogLoop();
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    std::multimap<std::chrono::steady_clock::time_point, size_t> m_deadlines;
+    std::unordered_map<size_t, Watch> m_watches;
+    size_t m_nextTicket;
+    size_t m_running;
+    std::thread m_thread;
+    bool m_stop;
+};
+
+#endif // WATCHDOG_H
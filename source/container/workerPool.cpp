@@ -0,0 +1,324 @@
+// Implementation of the work-stealing worker pool shared (through the container) by every plugin in the application.
+
+#include "stdafx.h" // this header needs to come first
+#include <exception>
+#include <iostream>
+#include "workerPool.h"
+
+namespace
+{
+    // Identifies the pool (and the worker index inside it) that the current thread belongs to, if any.
+    thread_local WorkerPool* t_pool = nullptr;
+    thread_local size_t t_worker = 0;
+
+    size_t defaultWorkerCount()
+    {
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 0 ? hardwareThreads : 1;
+    }
+}
+
+WorkerPool::WorkerPool()
+    : m_pending(0), m_sleeping(0), m_running(false), m_workerCount(0), m_stop(false)
+{}
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+size_t WorkerPool::getWorkerCount()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_workerCount == 0 ? defaultWorkerCount() : m_workerCount;
+}
+
+void WorkerPool::setWorkerCount(size_t count)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_running)
+    {
+        std::cout << "The worker pool is already running; unable to change its worker count to " << count << std::endl;
+        return;
+    }
+    m_workerCount = count;
+}
+
+void WorkerPool::submit(std::function<void()> task)
+{
+    if (!m_running)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (!m_running)
+        {
+            start();
+        }
+    }
+
+    if (t_pool == this)
+    {
+        WorkerQueue& queue = *m_queues[t_worker];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_injected.push_back(std::move(task));
+    }
+
+    ++m_pending;
+    wake();
+}
+
+void WorkerPool::submitLongRunning(std::function<void()> task)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    reapLongRunning();
+
+    LongRunningThread longRunning;
+    longRunning.done = std::make_shared<std::atomic<bool>>(false);
+    std::shared_ptr<std::atomic<bool>> done = longRunning.done;
+    longRunning.thread = std::thread([task, done]() { task(); *done = true; });
+    m_longRunning.push_back(std::move(longRunning));
+}
+
+bool WorkerPool::runPendingTask()
+{
+    // The deques are only built by start(), which sets m_running once they're complete, and never touched again until the
+    // pool is destroyed, so they're safe to walk without m_lock once m_running is set.
+    if (!m_running)
+    {
+        return false;
+    }
+
+    std::function<void()> task;
+    bool found = (t_pool == this) ? findTask(t_worker, task) : (popInjected(task) || stealTask(m_queues.size(), task));
+    if (found)
+    {
+        runTask(task);
+    }
+    return found;
+}
+
+// Spawn the worker threads along with their deques. Must be called with m_lock held, and only once: the deques outlive the
+// workers, since threads outside the pool may be walking them (see runPendingTask).
+void WorkerPool::start()
+{
+    size_t count = m_workerCount == 0 ? defaultWorkerCount() : m_workerCount;
+
+    m_stop = false;
+    m_queues.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue));
+    }
+
+    m_workers.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_workers.push_back(std::thread(&WorkerPool::workerLoop, this, i));
+    }
+    m_running = true;
+}
+
+// Let the workers drain whatever is left in the queues, then join them (along with any long-running task threads).
+void WorkerPool::stop()
+{
+    std::vector<std::thread> workers;
+    std::vector<LongRunningThread> longRunning;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+        workers.swap(m_workers);
+        longRunning.swap(m_longRunning);
+    }
+    m_condition.notify_all();
+
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        if (workers[i].joinable())
+        {
+            workers[i].join();
+        }
+    }
+    for (size_t i = 0; i < longRunning.size(); ++i)
+    {
+        if (longRunning[i].thread.joinable())
+        {
+            longRunning[i].thread.join();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_running = false;
+}
+
+void WorkerPool::workerLoop(size_t index)
+{
+    t_pool = this;
+    t_worker = index;
+
+    while (true)
+    {
+        std::function<void()> task;
+        if (findTask(index, task))
+        {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        if (m_stop && m_pending == 0)
+        {
+            break;
+        }
+        ++m_sleeping;
+        m_condition.wait(lock, [this] { return m_stop || m_pending > 0; });
+        --m_sleeping;
+    }
+
+    t_pool = nullptr;
+}
+
+// Wake up a sleeping worker, if there is one. The pending counter is incremented before checking for sleepers, and a worker
+// registers itself as sleeping (under m_lock) before checking the pending counter, so a submission can never be missed.
+void WorkerPool::wake()
+{
+    if (m_sleeping > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_condition.notify_one();
+    }
+}
+
+// Look for work in the worker's own deque first (newest task), then in the injection queue, and finally steal from the others.
+bool WorkerPool::findTask(size_t index, std::function<void()>& task)
+{
+    {
+        WorkerQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.pop_back();
+            --m_pending;
+            return true;
+        }
+    }
+
+    return popInjected(task) || stealTask(index, task);
+}
+
+bool WorkerPool::popInjected(std::function<void()>& task)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_injected.empty())
+    {
+        return false;
+    }
+    task = m_injected.pop_front();
+    --m_pending;
+    return true;
+}
+
+// Steal the oldest task from another worker's deque, starting with the worker after the thief so that victims are spread out.
+bool WorkerPool::stealTask(size_t thief, std::function<void()>& task)
+{
+    size_t count = m_queues.size();
+    for (size_t i = 1; i <= count; ++i)
+    {
+        size_t victim = (thief + i) % count;
+        if (victim == thief)
+        {
+            continue;
+        }
+
+        WorkerQueue& queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.lock);
+        if (!queue.tasks.empty())
+        {
+            task = queue.tasks.pop_front();
+            --m_pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run a task, swallowing (and reporting) anything it throws. Tasks that care about their exceptions catch them themselves (e.g.
+// to hand them to a Completion); one that doesn't must neither kill its worker nor unwind a thread that's merely helping the
+// pool while it waits on something else.
+void WorkerPool::runTask(std::function<void()>& task)
+{
+    try
+    {
+        task();
+    }
+    catch (const std::exception& exception)
+    {
+        std::cout << "A task on the worker pool threw an exception (" << exception.what() << "); unable to report it to its submitter" << std::endl;
+    }
+    catch (...)
+    {
+        std::cout << "A task on the worker pool threw an exception; unable to report it to its submitter" << std::endl;
+    }
+}
+
+// Join the threads of long-running tasks that have already returned. Must be called with m_lock held.
+void WorkerPool::reapLongRunning()
+{
+    auto it = m_longRunning.begin();
+    while (it != m_longRunning.end())
+    {
+        if (*it->done)
+        {
+            it->thread.join();
+            it = m_longRunning.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool WorkerPool::TaskQueue::empty() const
+{
+    return m_size == 0;
+}
+
+void WorkerPool::TaskQueue::push_back(std::function<void()>&& task)
+{
+    if (m_size == m_tasks.size())
+    {
+        grow();
+    }
+    m_tasks[(m_head + m_size) % m_tasks.size()] = std::move(task);
+    ++m_size;
+}
+
+std::function<void()> WorkerPool::TaskQueue::pop_back()
+{
+    --m_size;
+    return std::move(m_tasks[(m_head + m_size) % m_tasks.size()]);
+}
+
+std::function<void()> WorkerPool::TaskQueue::pop_front()
+{
+    std::function<void()> task = std::move(m_tasks[m_head]);
+    m_head = (m_head + 1) % m_tasks.size();
+    --m_size;
+    return task;
+}
+
+// Double the capacity, unrolling the ring so that the oldest task ends up at the front.
+void WorkerPool::TaskQueue::grow()
+{
+    std::vector<std::function<void()>> tasks(m_tasks.empty() ? 64 : m_tasks.size() * 2);
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        tasks[i] = std::move(m_tasks[(m_head + i) % m_tasks.size()]);
+    }
+    m_tasks.swap(tasks);
+    m_head = 0;
+}
@@ -0,0 +1,94 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkerPool is a work-stealing task executor. A single instance lives inside the container so that every loaded plugin
+// (and by extension every EventStream) hands its asynchronous work to the same set of long-lived worker threads, rather
+// than each plugin creating and joining threads of its own.
+// Every worker owns a deque of tasks: tasks submitted from a worker are pushed onto its own deque and popped back LIFO
+// (keeping caches warm for nested work), tasks submitted from any other thread go into a shared injection queue, and a
+// worker that runs out of work steals the oldest task from the other workers' deques.
+class WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    // Number of worker threads the pool runs with. A count of 0 means one worker per hardware thread.
+    size_t getWorkerCount();
+    // Change the number of worker threads. Only possible at start-up (e.g. from startup.cfg), before the first task is
+    // submitted: threads waiting on tasks walk the workers' deques without locking the pool, so they can't be replaced
+    // once the workers are running.
+    void setWorkerCount(size_t count);
+
+    // Queue a short task for execution on one of the workers. The workers are lazily started on the first submission.
+    void submit(std::function<void()> task);
+    // Run a task that lives for a long time (e.g. a plugin's update loop) without taking one of the workers out of
+    // rotation; the pool hands it a dedicated thread that is reclaimed once the task returns.
+    void submitLongRunning(std::function<void()> task);
+    // Run a single pending task on the calling thread, if there is one. Lets a thread that is waiting on submitted
+    // tasks help drain the queues instead of idling (and prevents workers waiting on other tasks from starving them).
+    bool runPendingTask();
+
+private:
+    // Growable ring buffer of tasks. Unlike std::deque, it never gives memory back while tasks are pushed and popped, so
+    // once it has grown to the pool's working size, queueing a task (that fits in std::function's local storage) is allocation-free.
+    class TaskQueue
+    {
+    public:
+        bool empty() const;
+        void push_back(std::function<void()>&& task);
+        std::function<void()> pop_back();
+        std::function<void()> pop_front();
+
+    private:
+        void grow();
+
+        std::vector<std::function<void()>> m_tasks;
+        size_t m_head = 0;
+        size_t m_size = 0;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex lock;
+        TaskQueue tasks;
+    };
+
+    struct LongRunningThread
+    {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+
+    void start();
+    void stop();
+    void workerLoop(size_t index);
+    void wake();
+    bool findTask(size_t index, std::function<void()>& task);
+    bool popInjected(std::function<void()>& task);
+    bool stealTask(size_t thief, std::function<void()>& task);
+    static void runTask(std::function<void()>& task);
+    void reapLongRunning();
+
+    std::mutex m_lock;
+    std::condition_variable m_condition;
+    TaskQueue m_injected;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::vector<LongRunningThread> m_longRunning;
+    std::atomic<size_t> m_pending;
+    std::atomic<size_t> m_sleeping;
+    std::atomic<bool> m_running;
+    size_t m_workerCount;
+    bool m_stop;
+};
+
+#endif // WORKERPOOL_H
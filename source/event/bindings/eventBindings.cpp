@@ -103,17 +103,27 @@ namespace
             }
         }
 
-        void call(const char* eventName, T params)
+        void call(const char* eventName, const T& params)
         {
             es->call(eventName, params);
         }
 
-        void callAsyncBlocking(const char* eventName, T params)
+        // The future returned by EventStream::callAsyncBlocking doesn't block when it's destroyed, so wait on it explicitly.
+        void callAsyncBlocking(const char* eventName, const T& params)
         {
             std::future<void> f = es->callAsyncBlocking(eventName, params);
+            if (f.valid())
+            {
+                f.wait();
+            }
+        }
+
+        Completion dispatch(const char* eventName, const T& params)
+        {
+            return es->dispatch(eventName, params);
         }
 
-        void callAsync(const char* eventName, T params)
+        void callAsync(const char* eventName, const T& params)
         {
             es->callAsync(eventName, params);
         }
@@ -140,7 +150,8 @@ namespace
             .def("unsubscribe", static_cast<void (EventStreamPython<T>::*)(const char*, const std::vector<size_t>&)>(&EventStreamPython<T>::unsubscribe), "Unsubscribe multiple handlers (functions) in a vector from a named Event simultaneously.")
             .def("unsubscribe", static_cast<void(EventStreamPython<T>::*)(const char*, const pybind11::args)>(&EventStreamPython<T>::unsubscribe), "Unsubscribe multiple handlers (functions) in a vector from a named Event simultaneously.")
             .def("call", &EventStreamPython<T>::call, "Sequentially call each EventHandler in an Event.")
-            .def("callAsyncBlocking", &EventStreamPython<T>::callAsyncBlocking, "Call the same Event in multiple threads.")
+            .def("callAsyncBlocking", &EventStreamPython<T>::callAsyncBlocking, "Call the same Event in multiple threads.", pybind11::call_guard<pybind11::gil_scoped_release>())
+            .def("dispatch", &EventStreamPython<T>::dispatch, "Run the Event's EventHandlers on the worker pool without waiting; returns a Completion.")
             .def("callAsync", &EventStreamPython<T>::callAsync, "Run the Event's EventHandlers in their own, separate threads.");
     }
 }
@@ -149,6 +160,13 @@ PYBIND11_MODULE(eventPython, m)
 {
     m.doc() = "pybind11 event python bindings"; // optional module docstring
     
+    // The GIL is released while waiting, since the handlers being waited on may be python functions run on pool threads.
+    pybind11::class_<Completion>(m, "Completion")
+        .def(pybind11::init<>())
+        .def("is_ready", &Completion::isReady, "Whether every handler of the dispatch has finished.")
+        .def("wait", &Completion::wait, "Block until every handler of the dispatch has finished.", pybind11::call_guard<pybind11::gil_scoped_release>())
+        .def_static("when_all", &Completion::whenAll, "A Completion that becomes ready once all the given Completions are.");
+
     declare_eventstream<double>(m, "double");
     declare_eventstream<std::string>(m, "std::string");
     declare_eventstream<std::vector<double>>(m, "std::vector<double>");
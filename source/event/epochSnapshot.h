@@ -0,0 +1,148 @@
+#ifndef EPOCHSNAPSHOT_H
+#define EPOCHSNAPSHOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// EpochSnapshot holds an immutable value of type T that readers use without locking, copying or reference counting, while a
+// writer replaces it by publishing a new one. A reader registers itself in one of two counters (picked by the parity of the
+// current epoch) before loading the pointer and unregisters once it's done with it. A replaced value is retired along with the
+// epoch it was retired in, and freed once the epoch has advanced twice; the epoch only advances past a parity whose readers
+// have all left, so no reader can still hold a value by the time it's freed. Publishing never blocks: values whose readers are
+// still in flight are reclaimed on a later publish, or by the destructor.
+// publish() must be serialized by the owner (e.g. with a write lock); readers may run concurrently with everything but the
+// destructor.
+template <typename T> class EpochSnapshot
+{
+public:
+    // RAII helper that registers the current thread as a reader. The value it loaded stays alive for as long as the guard exists.
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const EpochSnapshot<T>& snapshot)
+            : m_snapshot(snapshot), m_parity(snapshot.enter()), m_value(snapshot.load())
+        {}
+
+        ~ReadGuard()
+        {
+            m_snapshot.leave(m_parity);
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        const T* get() const
+        {
+            return m_value;
+        }
+
+        const T& operator*() const
+        {
+            return *m_value;
+        }
+
+        const T* operator->() const
+        {
+            return m_value;
+        }
+
+    private:
+        const EpochSnapshot<T>& m_snapshot;
+        size_t m_parity;
+        const T* m_value;
+    };
+
+    // Starts out holding the given value, which may be nullptr.
+    explicit EpochSnapshot(const T* initial = new T)
+        : m_current(initial)
+    {}
+
+    ~EpochSnapshot()
+    {
+        delete m_current.load();
+        for (const auto& retired : m_retired)
+        {
+            delete retired.first;
+        }
+    }
+
+    EpochSnapshot(const EpochSnapshot&) = delete;
+    EpochSnapshot& operator=(const EpochSnapshot&) = delete;
+
+    // Register a reader and return the parity to hand back to leave(). For readers whose use of the value outlives a scope
+    // (e.g. one that is handed over to pool tasks); everything else should use a ReadGuard.
+    size_t enter() const
+    {
+        size_t parity = m_epoch.load() & 1;
+        m_readers[parity].fetch_add(1);
+        return parity;
+    }
+
+    void leave(size_t parity) const
+    {
+        m_readers[parity].fetch_sub(1);
+    }
+
+    // The current value. Only safe to dereference between enter() and leave(), or while holding the owner's write lock.
+    const T* load() const
+    {
+        return m_current.load();
+    }
+
+    // Returns true if no reader is registered.
+    bool idle() const
+    {
+        return m_readers[0].load() == 0 && m_readers[1].load() == 0;
+    }
+
+    // Swap in a new value (which may be nullptr) and retire the previous one. Must be serialized by the owner.
+    void publish(const T* value)
+    {
+        const T* old = m_current.exchange(value);
+        if (old != nullptr)
+        {
+            m_retired.push_back(std::make_pair(old, m_epoch.load()));
+        }
+        reclaim();
+    }
+
+private:
+    // Free every retired value that no reader can still hold. A value retired during epoch E can be freed once the epoch reaches
+    // E + 2, and the epoch only advances past E + 1 when the readers that entered during the reused parity have drained.
+    void reclaim()
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            size_t epoch = m_epoch.load();
+            if (m_readers[(epoch + 1) & 1].load() != 0) break;
+            m_epoch.store(epoch + 1);
+        }
+
+        size_t epoch = m_epoch.load();
+        auto it = m_retired.begin();
+        while (it != m_retired.end())
+        {
+            if (it->second + 2 <= epoch)
+            {
+                delete it->first;
+                it = m_retired.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // The currently-published value.
+    std::atomic<const T*> m_current;
+    // Reclamation epoch, and the number of in-flight readers that entered during an even/odd epoch.
+    mutable std::atomic<size_t> m_epoch = 0;
+    mutable std::atomic<size_t> m_readers[2] = { 0, 0 };
+    // Values that have been swapped out, paired with the epoch during which they were retired.
+    std::vector<std::pair<const T*, size_t>> m_retired;
+};
+
+#endif // EPOCHSNAPSHOT_H
@@ -0,0 +1,487 @@
+#ifndef REDUCEEVENTSTREAM_H
+#define REDUCEEVENTSTREAM_H
+
+#include <exception>
+#include <optional>
+
+#include "event.h"
+
+// EventStream<R(Args...)> is the map-reduce flavour of EventStream: the handlers of its Events return a value of type R, and
+// calling an Event combines the values returned by all of its handlers into a single result, using a reduction supplied by the
+// caller (a sum, a minimum, a vote count...), or collects them into a vector. This lets plugins query their subscribers (e.g. for
+// cost estimates or partial sums) instead of having every handler write to shared globals. For example:
+//     EventStream<int(double)>* es = EventStream<int(double)>::Instance(identifier);
+//     es->create("estimate_cost");
+//     es->subscribe("estimate_cost", [](double load) { return int(load * 10.0); });
+//     int totalCost = es->call("estimate_cost", 0, std::plus<int>(), 1.5);
+// The Events are stored in the container along with those of every other EventStream, so their names have to be unique across
+// all EventStreams.
+template <typename R, typename... Args> class EventStream<R(Args...)>
+{
+    static_assert(!std::is_void_v<R>, "Use EventStream<Args...> for Events whose handlers don't return anything.");
+
+public:
+    class Event;
+
+    // Wrapper for a function subscribed to an Event, along with the id that the Event assigned to it.
+    class EventHandler
+    {
+    public:
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, EventHandler>>>
+        explicit EventHandler(F&& handlerFunc)
+            : m_handlerFunc(std::forward<F>(handlerFunc))
+        {}
+
+        size_t id() const
+        {
+            return m_handlerId;
+        }
+
+        // Function call operator.
+        R operator()(const Args&... params) const
+        {
+            return m_handlerFunc(params...);
+        }
+
+    private:
+        friend class Event;
+
+        size_t m_handlerId = 0;
+        InlineFunction<R(const Args&...), 64> m_handlerFunc;
+    };
+
+    // An Event whose handlers return values. As with the regular Events, calls read an immutable snapshot of the handler list
+    // without locking, while subscribing and unsubscribing publish a new one (see EpochSnapshot).
+    class Event
+    {
+    public:
+        // Add a handler to the Event. Returns its unique id.
+        size_t add(EventHandler handler)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            std::vector<EventHandler>* handlers = new std::vector<EventHandler>(*m_handlers.load());
+            handler.m_handlerId = ++m_idCounter;
+            handlers->push_back(std::move(handler));
+            m_handlers.publish(handlers);
+            return m_idCounter;
+        }
+
+        // Remove the handlers with the given ids from the Event.
+        void remove_id(const std::vector<size_t>& handlerIds)
+        {
+            std::lock_guard<std::mutex> lock(m_writeLock);
+            std::vector<EventHandler>* handlers = new std::vector<EventHandler>;
+            for (const auto& handler : *m_handlers.load())
+            {
+                if (std::find(handlerIds.begin(), handlerIds.end(), handler.id()) == handlerIds.end())
+                {
+                    handlers->push_back(handler);
+                }
+            }
+            m_handlers.publish(handlers);
+        }
+
+        // Call every handler in sequence, and fold their results into init with reduce, in subscription order.
+        template <typename Reduce> R call(R init, Reduce& reduce, const Args&... params)
+        {
+            ReadGuard guard(m_handlers);
+            R result = std::move(init);
+            for (const auto& handler : *guard)
+            {
+                result = reduce(std::move(result), handler(params...));
+            }
+            return result;
+        }
+
+        // Run the handlers concurrently on the shared worker pool, combining their results pairwise in a reduction tree (the
+        // handler list is split in halves, one of which is handed to the pool while the calling thread works on the other,
+        // recursively), and finally fold the combined result into init. reduce therefore has to be associative, but the
+        // order of the handlers is preserved, so it needn't be commutative.
+        template <typename Reduce> R callAsync(R init, Reduce& reduce, const Args&... params)
+        {
+            ReadGuard guard(m_handlers);
+            const std::vector<EventHandler>& handlers = *guard;
+            if (handlers.empty())
+            {
+                return init;
+            }
+            std::tuple<const Args&...> args(params...);
+            return reduce(std::move(init), reduceRange(handlers, 0, handlers.size(), reduce, args));
+        }
+
+        // Call every handler in sequence and return their results, in subscription order.
+        std::vector<R> collect(const Args&... params)
+        {
+            ReadGuard guard(m_handlers);
+            std::vector<R> results; results.reserve(guard->size());
+            for (const auto& handler : *guard)
+            {
+                results.push_back(handler(params...));
+            }
+            return results;
+        }
+
+        // Run the handlers concurrently on the shared worker pool and return their results, in subscription order.
+        std::vector<R> collectAsync(const Args&... params)
+        {
+            std::vector<std::optional<R>> partials = fanOut(params...);
+            std::vector<R> results; results.reserve(partials.size());
+            for (auto& partial : partials)
+            {
+                results.push_back(std::move(*partial));
+            }
+            return results;
+        }
+
+        // Returns true if no thread is currently calling the Event.
+        bool isExecutionComplete() const
+        {
+            return m_handlers.idle();
+        }
+
+    private:
+        // Keeps the snapshot of the handler list alive during a call, and lets destroy() know a call is in flight.
+        typedef typename EpochSnapshot<std::vector<EventHandler>>::ReadGuard ReadGuard;
+
+        // Wait for the tasks tracked by a Completion without rethrowing their exceptions, for when the calling thread is already
+        // unwinding one of its own.
+        static void waitQuietly(const Completion& completion)
+        {
+            try
+            {
+                completion.wait();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // Helper function for callAsync. Reduces the results of the handlers in [begin, end).
+        template <typename Reduce> R reduceRange(const std::vector<EventHandler>& handlers, size_t begin, size_t end, Reduce& reduce,
+            const std::tuple<const Args&...>& args)
+        {
+            if (end - begin == 1)
+            {
+                return std::apply(handlers[begin], args);
+            }
+
+            // The right half's task holds its own copy of the Completion, which keeps the token's state alive until complete()
+            // returns, even though the waiting thread may already have moved on by then.
+            size_t middle = begin + (end - begin) / 2;
+            std::optional<R> right;
+            Completion rightDone(m_container, 1);
+            m_container->submitTask([&, rightDone]()
+            {
+                std::exception_ptr error;
+                try
+                {
+                    right.emplace(reduceRange(handlers, middle, end, reduce, args));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                rightDone.complete(error);
+            });
+
+            std::optional<R> left;
+            try
+            {
+                left.emplace(reduceRange(handlers, begin, middle, reduce, args));
+            }
+            catch (...)
+            {
+                waitQuietly(rightDone);
+                throw;
+            }
+            rightDone.wait();
+            return reduce(std::move(*left), std::move(*right));
+        }
+
+        // Helper function for collectAsync. Runs every handler but the first on the worker pool, each storing its result in
+        // its own entry, runs the first one on the calling thread, and waits for all of them.
+        std::vector<std::optional<R>> fanOut(const Args&... params)
+        {
+            ReadGuard guard(m_handlers);
+            const std::vector<EventHandler>& handlers = *guard;
+            std::vector<std::optional<R>> results(handlers.size());
+            if (handlers.empty())
+            {
+                return results;
+            }
+
+            std::tuple<const Args&...> args(params...);
+            Completion othersDone(m_container, handlers.size() - 1);
+            for (size_t i = 1; i < handlers.size(); ++i)
+            {
+                m_container->submitTask([&, i, othersDone]()
+                {
+                    std::exception_ptr error;
+                    try
+                    {
+                        results[i].emplace(std::apply(handlers[i], args));
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    othersDone.complete(error);
+                });
+            }
+
+            try
+            {
+                results[0].emplace(std::apply(handlers[0], args));
+            }
+            catch (...)
+            {
+                waitQuietly(othersDone);
+                throw;
+            }
+            othersDone.wait();
+            return results;
+        }
+
+        std::mutex m_writeLock;
+        EpochSnapshot<std::vector<EventHandler>> m_handlers;
+        size_t m_idCounter = 0;
+    };
+
+    void requestDelete()
+    {
+        std::string type = streamType();
+        std::cout << "_______________EventStream<" << type << "> requestDelete has been called_______________" << std::endl;
+
+        // If only one reference exists for the EventStream we wish to delete, then destruct that EventStream. Otherwise
+        // simply decrement its reference counter.
+        if (m_container->getEventStreamRefCount().find(type) != m_container->getEventStreamRefCount().end())
+        {
+            if (m_container->getEventStreamRefCount().at(type) > 1)
+            {
+                m_container->subtractEventStreamRefCount(type);
+            }
+            else
+            {
+                delete static_cast<EventStream*>(m_container->getEventStreams().at(type));
+                m_container->eraseEventStream(type);
+                m_container->eraseEventStreamRefCount(type);
+            }
+        }
+    }
+
+    // Note that, like every EventStream, EventStream<R(Args...)> is a singleton. The size_t identifier is a hashed representation
+    // of the app's executable directory.
+    static EventStream* Instance(size_t identifier)
+    {
+        EventStream<>::loadContainer(identifier);
+        m_container = EventStream<>::m_container;
+
+        std::string type = streamType();
+        if (m_container->getEventStreams().find(type) == m_container->getEventStreams().end())
+        {
+            std::cout << "______________A new EventStream<" << type << "> has been created______________" << std::endl;
+            EventStream* es = new EventStream;
+            m_container->addEventStream(type, static_cast<void*>(es));
+            m_container->addEventStreamRefCount(type);
+            return es;
+        }
+        else
+        {
+            std::cout << "______________EventStream<" << type << "> already exists______________" << std::endl;
+            m_container->addEventStreamRefCount(type);
+            return static_cast<EventStream*>(m_container->getEventStreams()[type]);
+        }
+    }
+
+    // Create a new Event. If it already exists, simply add a reference to it.
+    void create(const EventKey& eventName)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        if (getEvent(eventName) != nullptr)
+        {
+            if (!m_container->addEventRefCount(eventName))
+            {
+                std::cout << "ERROR: Event name " << eventName.name() << " collides with the key of another Event; unable to create." << std::endl;
+            }
+        }
+        else
+        {
+            Event* newEvent = new Event;
+            if (m_container->addEvent(eventName, static_cast<void*>(newEvent)))
+            {
+                m_container->addEventRefCount(eventName);
+            }
+            else
+            {
+                std::cout << "ERROR: Event name " << eventName.name() << " collides with the key of another Event; unable to create." << std::endl;
+                delete newEvent;
+            }
+        }
+    }
+
+    // Destroy the Event specified by its name (once the last reference to it is released).
+    void destroy(const EventKey& eventName)
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock);
+
+        Event* eventPtr = getEvent(eventName);
+        if (eventPtr == nullptr)
+        {
+            std::cout << "Event with name " << eventName.name() << " could not be found, and thus cannot be destroyed." << std::endl;
+            return;
+        }
+
+        if (m_container->getEventRefCount()[eventName.hash()] > 1)
+        {
+            m_container->subtractEventRefCount(eventName);
+        }
+        else
+        {
+            // Wait for the Event to finish any calls in the middle of computation before deleting, helping the worker pool run
+            // them in case they are queued behind the calling task.
+            while (!eventPtr->isExecutionComplete())
+            {
+                if (!m_container->runPendingTask())
+                {
+                    std::this_thread::yield();
+                }
+            }
+            delete eventPtr;
+            m_container->eraseEvent(eventName);
+            m_container->eraseEventRefCount(eventName);
+        }
+    }
+
+    // Subscribe any number of callables (std::functions, function pointers, lambdas) returning R to a named Event. Returns a vector
+    // of unique ids that map to the handler functions we subscribed.
+    template<typename T, typename... Args2>
+    std::vector<size_t> subscribe(const EventKey& eventName, T firstHandlerFunc, Args2... handlerFuncs)
+    {
+        static_assert(std::is_convertible_v<std::invoke_result_t<T&, const Args&...>, R>
+            && std::conjunction_v<std::is_convertible<std::invoke_result_t<Args2&, const Args&...>, R>...>,
+            "Every handler must be callable with the Event's arguments and return the Event's result type.");
+        if (Event* event = getEvent(eventName))
+        {
+            std::vector<size_t> ids; ids.reserve(sizeof...(handlerFuncs) + 1);
+            ids.push_back(event->add(EventHandler(std::move(firstHandlerFunc))));
+            (ids.push_back(event->add(EventHandler(std::move(handlerFuncs)))), ...);
+            return ids;
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform subscription." << std::endl;
+            return std::vector<size_t>();
+        }
+    }
+
+    // Unsubscribe multiple functions simultaneously from an Event using a list of unique ids that map to each handler.
+    void unsubscribe(const EventKey& eventName, const std::vector<size_t>& handlerIds)
+    {
+        if (Event* event = getEvent(eventName))
+        {
+            event->remove_id(handlerIds);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to perform unsubscription." << std::endl;
+        }
+    }
+
+    // Call each handler of a name-specified Event in sequence and fold their results into init with reduce, which is called as
+    // reduce(R accumulated, R result). Returns init if the Event doesn't exist or has no handlers.
+    template <typename Reduce> R call(const EventKey& eventName, R init, Reduce reduce, const Args&... params)
+    {
+        if (Event* event = getEvent(eventName))
+        {
+            return event->call(std::move(init), reduce, params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to call." << std::endl;
+            return init;
+        }
+    }
+
+    // Run the handlers of a name-specified Event concurrently on the shared worker pool and combine their results with reduce in
+    // a reduction tree, folding the combined result into init. reduce must be associative.
+    template <typename Reduce> R callAsync(const EventKey& eventName, R init, Reduce reduce, const Args&... params)
+    {
+        if (Event* event = getEvent(eventName))
+        {
+            return event->callAsync(std::move(init), reduce, params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to callAsync." << std::endl;
+            return init;
+        }
+    }
+
+    // Call each handler of a name-specified Event in sequence and return their results in subscription order.
+    std::vector<R> collect(const EventKey& eventName, const Args&... params)
+    {
+        if (Event* event = getEvent(eventName))
+        {
+            return event->collect(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to collect." << std::endl;
+            return std::vector<R>();
+        }
+    }
+
+    // Run the handlers of a name-specified Event concurrently on the shared worker pool and return their results in subscription order.
+    std::vector<R> collectAsync(const EventKey& eventName, const Args&... params)
+    {
+        if (Event* event = getEvent(eventName))
+        {
+            return event->collectAsync(params...);
+        }
+
+        else
+        {
+            std::cout << "No Event named " << eventName.name() << " exists; unable to collectAsync." << std::endl;
+            return std::vector<R>();
+        }
+    }
+
+private:
+    static inline Container* m_container = nullptr;
+    std::recursive_mutex m_lock;
+
+    EventStream() = default;
+    ~EventStream() = default;
+
+    // The specialization type the EventStream is registered under in the container, obtained from a function signature the
+    // same way as for EventStream<Args...>. The whole signature R(Args...) is passed in as a template parameter pack, since
+    // the type string of the arguments alone would be the same as that of EventStream<Args...>.
+    static std::string streamType()
+    {
+        std::string type;
+        signatureType<R(Args...)>(type);
+        return type;
+    }
+
+    template <typename... Signature> static void signatureType(std::string& type)
+    {
+        #ifdef _WIN32
+        type = EventStream<>::esType(__FUNCSIG__);
+        #elif __linux__
+        type = EventStream<>::esType(__PRETTY_FUNCTION__);
+        #endif
+    }
+
+    Event* getEvent(const EventKey& eventName) const
+    {
+        return static_cast<Event*>(m_container->getEvent(eventName));
+    }
+};
+
+#endif // REDUCEEVENTSTREAM_H
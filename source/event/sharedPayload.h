@@ -0,0 +1,191 @@
+#ifndef SHAREDPAYLOAD_H
+#define SHAREDPAYLOAD_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// SharedPayload is an immutable, atomically reference-counted handle to a value of type T, meant for payloads that have to
+// outlive the publisher's stack (e.g. when they are posted, or handed to callAsyncBlocking) and that are read by several
+// subscribers, possibly on different threads. The value is constructed once, in a block taken from a per-type pool, and
+// every copy of the handle only bumps the reference count; the value is destroyed, and its block returned to the pool, when
+// the last handle goes away. Publishing a large frame on an EventStream<SharedPayload<std::vector<double>>> therefore costs
+// one allocation (which the pool recycles) and a pointer copy per delivery, rather than a deep copy of the vector.
+// The value cannot be modified through a SharedPayload, so it's safe to read from any number of threads at once.
+template <typename T> class SharedPayload
+{
+public:
+    // An empty handle.
+    SharedPayload() = default;
+
+    // Construct a new value in place and return the only handle to it.
+    template <typename... ValueArgs> static SharedPayload make(ValueArgs&&... valueArgs)
+    {
+        void* memory = Pool::instance().allocate();
+        Block* block;
+        try
+        {
+            block = new (memory) Block(std::forward<ValueArgs>(valueArgs)...);
+        }
+        catch (...)
+        {
+            Pool::instance().release(memory);
+            throw;
+        }
+        return SharedPayload(block);
+    }
+
+    SharedPayload(const SharedPayload& src)
+        : m_block(src.m_block)
+    {
+        if (m_block != nullptr)
+        {
+            m_block->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedPayload(SharedPayload&& src) noexcept
+        : m_block(src.m_block)
+    {
+        src.m_block = nullptr;
+    }
+
+    ~SharedPayload()
+    {
+        reset();
+    }
+
+    SharedPayload& operator=(const SharedPayload& src)
+    {
+        SharedPayload(src).swap(*this);
+        return *this;
+    }
+
+    SharedPayload& operator=(SharedPayload&& src) noexcept
+    {
+        SharedPayload(std::move(src)).swap(*this);
+        return *this;
+    }
+
+    void swap(SharedPayload& other) noexcept
+    {
+        std::swap(m_block, other.m_block);
+    }
+
+    // Drop this handle's reference, leaving it empty.
+    void reset()
+    {
+        if (m_block != nullptr && m_block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_block->~Block();
+            Pool::instance().release(m_block);
+        }
+        m_block = nullptr;
+    }
+
+    const T& operator*() const
+    {
+        return m_block->value;
+    }
+
+    const T* operator->() const
+    {
+        return &m_block->value;
+    }
+
+    const T* get() const
+    {
+        return m_block != nullptr ? &m_block->value : nullptr;
+    }
+
+    explicit operator bool() const
+    {
+        return m_block != nullptr;
+    }
+
+    // Number of handles currently sharing the value (0 for an empty handle). Only a hint while other threads hold handles.
+    size_t useCount() const
+    {
+        return m_block != nullptr ? m_block->references.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    struct Block
+    {
+        template <typename... ValueArgs> explicit Block(ValueArgs&&... valueArgs)
+            : references(1), value(std::forward<ValueArgs>(valueArgs)...)
+        {}
+
+        std::atomic<size_t> references;
+        const T value;
+    };
+
+    // Free list of blocks for one payload type. Blocks are kept around for reuse, up to MaxCached of them, so that publishing
+    // frames at a steady rate stops allocating once the pool has warmed up.
+    class Pool
+    {
+    public:
+        static constexpr size_t MaxCached = 64;
+
+        static Pool& instance()
+        {
+            static Pool pool;
+            return pool;
+        }
+
+        ~Pool()
+        {
+            for (void* memory : m_free)
+            {
+                ::operator delete(memory);
+            }
+        }
+
+        void* allocate()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (!m_free.empty())
+                {
+                    void* memory = m_free.back();
+                    m_free.pop_back();
+                    return memory;
+                }
+            }
+            return ::operator new(sizeof(Block));
+        }
+
+        void release(void* memory)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (m_free.size() < MaxCached)
+                {
+                    m_free.push_back(memory);
+                    return;
+                }
+            }
+            ::operator delete(memory);
+        }
+
+    private:
+        Pool()
+        {
+            m_free.reserve(MaxCached);
+        }
+
+        std::mutex m_lock;
+        std::vector<void*> m_free;
+    };
+
+    explicit SharedPayload(Block* block)
+        : m_block(block)
+    {}
+
+    Block* m_block = nullptr;
+};
+
+#endif // SHAREDPAYLOAD_H
@@ -0,0 +1,77 @@
+// Checks that a handler throwing during callAsync, whether it runs on the worker pool, on an executor or on the calling thread,
+// reaches the caller once every other handler is done, and that neither the pool nor the executor dies of it.
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+
+#include "event.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "asyncTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("async_test");
+
+    std::atomic<int> ran(0);
+    es->subscribe("async_test", [&](int) { ++ran; });
+    std::vector<size_t> poolThrower = es->subscribe("async_test", [&](int) { ++ran; throw std::runtime_error("pool"); }, Affinity::pool());
+    std::vector<size_t> poolThrower2 = es->subscribe("async_test", [&](int) { ++ran; throw std::runtime_error("pool"); }, Affinity::pool());
+    es->subscribe("async_test", [&](int) { ++ran; });
+
+    for (int round = 0; round < 20; ++round)
+    {
+        ran = 0;
+        bool caught = false;
+        try
+        {
+            es->callAsync("async_test", round);
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        CHECK(caught);
+        CHECK(ran == 4);
+    }
+    es->unsubscribe("async_test", poolThrower);
+    es->unsubscribe("async_test", poolThrower2);
+
+    std::vector<size_t> executorThrower = es->subscribe("async_test", [&](int) { ++ran; throw std::runtime_error("executor"); },
+        Affinity::executor("async_test_executor"));
+    ran = 0;
+    bool caught = false;
+    try
+    {
+        es->callAsync("async_test", 1);
+    }
+    catch (const std::runtime_error& error)
+    {
+        caught = std::string(error.what()) == "executor";
+    }
+    CHECK(caught);
+    CHECK(ran == 3);
+    es->unsubscribe("async_test", executorThrower);
+
+    // Tasks that throw on their own are reported and dropped; the pool and the executor keep running the following ones.
+    Container* pool = container();
+    pool->submitTask([] { throw std::runtime_error("stray"); });
+    std::promise<void> poolAlive;
+    pool->submitTask([&] { poolAlive.set_value(); });
+    CHECK(poolAlive.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    size_t executor = pool->getExecutor("async_test_executor", -1);
+    pool->submitToExecutor(executor, [] { throw 42; });
+    std::promise<void> executorAlive;
+    pool->submitToExecutor(executor, [&] { executorAlive.set_value(); });
+    CHECK(executorAlive.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    ran = 0;
+    es->callAsync("async_test", 2);
+    CHECK(ran == 2);
+
+    es->destroy("async_test");
+    es->requestDelete();
+    return testResult("asyncTest");
+}
@@ -0,0 +1,75 @@
+// Checks batch handlers: a drain hands them every posted call at once, in posting order, a callBatch its whole batch, and a
+// plain call (synchronous or asynchronous) a batch of one, for single-argument Events (contiguous arguments) as well as
+// multi-argument ones (tuples), while the per-call handlers still see every call.
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "batchTest");
+    EventStream<double>* es = EventStream<double>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("batch_test");
+
+    std::vector<std::vector<double>> batches;
+    int perCall = 0;
+    size_t batchId = es->subscribeBatch("batch_test", [&](const double* payloads, size_t count)
+    {
+        batches.emplace_back(payloads, payloads + count);
+    });
+    CHECK(batchId != 0);
+    es->subscribe("batch_test", [&](double) { ++perCall; });
+
+    for (int i = 0; i < 5; ++i)
+    {
+        CHECK(es->post("batch_test", i * 1.5));
+    }
+    CHECK(es->drainPosted("batch_test") == 5);
+    CHECK(batches.size() == 1);
+    CHECK((batches.back() == std::vector<double>{ 0.0, 1.5, 3.0, 4.5, 6.0 }));
+    CHECK(perCall == 5);
+
+    es->callBatch("batch_test", std::vector<std::tuple<double>>{ { 1.0 }, { 2.0 }, { 3.0 } });
+    CHECK(batches.size() == 2);
+    CHECK((batches.back() == std::vector<double>{ 1.0, 2.0, 3.0 }));
+    CHECK(perCall == 8);
+
+    es->call("batch_test", 7.0);
+    CHECK(batches.size() == 3 && batches.back() == std::vector<double>{ 7.0 });
+    es->callAsync("batch_test", 8.0);
+    CHECK(batches.size() == 4 && batches.back() == std::vector<double>{ 8.0 });
+    CHECK(perCall == 10);
+
+    // A drain with nothing posted doesn't call the batch handlers.
+    CHECK(es->drainPosted("batch_test") == 0);
+    CHECK(batches.size() == 4);
+
+    es->unsubscribe("batch_test", batchId);
+    es->post("batch_test", 9.0);
+    es->drainPosted("batch_test");
+    CHECK(batches.size() == 4);
+    CHECK(perCall == 11);
+    es->destroy("batch_test");
+    es->requestDelete();
+
+    // Multi-argument Events hand their batch handlers tuples.
+    EventStream<int, std::string>* pairs = EventStream<int, std::string>::Instance(reinterpret_cast<size_t>(appDir()));
+    pairs->create("batch_pairs_test");
+    std::vector<std::tuple<int, std::string>> received;
+    pairs->subscribeBatch("batch_pairs_test", [&](const std::tuple<int, std::string>* payloads, size_t count)
+    {
+        received.assign(payloads, payloads + count);
+    });
+    pairs->post("batch_pairs_test", 1, std::string("one"));
+    pairs->post("batch_pairs_test", 2, std::string("two"));
+    pairs->drainPosted("batch_pairs_test");
+    CHECK(received.size() == 2 && received[0] == std::make_tuple(1, std::string("one")) && received[1] == std::make_tuple(2, std::string("two")));
+    pairs->destroy("batch_pairs_test");
+    pairs->requestDelete();
+
+    return testResult("batchTest");
+}
@@ -0,0 +1,118 @@
+// Checks Completion tokens: a token counts its tasks down and rethrows the first exception one of them reported, dispatch
+// hands one back that covers every handler, cancelling it lets a running handler give up and skips the handlers that haven't
+// started, and whenAll combines tokens, including their exceptions and cancellation.
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "event.h"
+#include "testUtils.h"
+
+bool throwsRuntimeError(const Completion& completion)
+{
+    try
+    {
+        completion.wait();
+    }
+    catch (const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "completionTest");
+    // A single worker, so that dispatched handlers run one after the other and the ones behind a blocked handler stay queued.
+    Container* pool = container();
+    pool->setWorkerCount(1);
+
+    Completion counted(pool, 2);
+    CHECK(!counted.isReady());
+    counted.complete();
+    CHECK(!counted.isReady());
+    counted.complete(std::make_exception_ptr(std::runtime_error("second")));
+    CHECK(counted.isReady());
+    CHECK(throwsRuntimeError(counted));
+    CHECK(Completion().isReady());
+
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("completion_test");
+
+    // Every handler has run by the time the token is ready.
+    std::atomic<int> ran(0);
+    std::vector<size_t> counters = es->subscribe("completion_test", [&](int) { ++ran; }, [&](int) { ++ran; }, [&](int) { ++ran; });
+    Completion dispatched = es->dispatch("completion_test", 1);
+    dispatched.wait();
+    CHECK(ran == 3);
+
+    std::vector<size_t> thrower = es->subscribe("completion_test", [](int value) { if (value == 2) throw std::runtime_error("handler"); });
+    CHECK(throwsRuntimeError(es->dispatch("completion_test", 2)));
+    es->unsubscribe("completion_test", thrower);
+    es->unsubscribe("completion_test", counters);
+
+    // The first handler blocks its worker until the dispatch is cancelled; the ones queued behind it never start.
+    std::atomic<bool> started(false);
+    std::atomic<bool> sawCancel(false);
+    ran = 0;
+    es->subscribe("completion_test", [&](int)
+    {
+        started = true;
+        while (!Completion::current().isCancelled())
+        {
+            std::this_thread::yield();
+        }
+        sawCancel = true;
+    });
+    es->subscribe("completion_test", [&](int) { ++ran; }, [&](int) { ++ran; });
+    Completion cancellable = es->dispatch("completion_test", 3);
+    while (!started.load())
+    {
+        std::this_thread::yield();
+    }
+    CHECK(!cancellable.isCancelled());
+    cancellable.cancel();
+    CHECK(cancellable.isCancelled());
+    cancellable.wait();
+    CHECK(sawCancel);
+    CHECK(ran == 0);
+
+    // whenAll becomes ready with the last of its tokens, and cancelling it cancels them all.
+    Completion first(pool, 1);
+    Completion second(pool, 1);
+    Completion both = Completion::whenAll({ first, second, Completion() });
+    first.complete();
+    CHECK(!both.isReady());
+    second.complete(std::make_exception_ptr(std::runtime_error("second")));
+    CHECK(both.isReady());
+    CHECK(throwsRuntimeError(both));
+    CHECK(Completion::whenAll({}).isReady());
+
+    Completion third(pool, 1);
+    Completion fourth(pool, 1);
+    Completion pair = Completion::whenAll({ third, fourth });
+    pair.cancel();
+    CHECK(third.isCancelled() && fourth.isCancelled());
+    third.complete();
+    fourth.complete();
+    pair.wait();
+
+    // Cancelling the dispatches through whenAll stops their blocked handlers too.
+    started = false;
+    sawCancel = false;
+    Completion dispatches = Completion::whenAll({ es->dispatch("completion_test", 4) });
+    while (!started.load())
+    {
+        std::this_thread::yield();
+    }
+    dispatches.cancel();
+    dispatches.wait();
+    CHECK(sawCancel);
+    CHECK(ran == 0);
+
+    es->destroy("completion_test");
+    es->requestDelete();
+    return testResult("completionTest");
+}
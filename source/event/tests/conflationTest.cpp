@@ -0,0 +1,77 @@
+// Checks conflated posting: a drain delivers only the latest call per conflation key (keys in the order they were first
+// posted), without a key function only the latest call overall, calls posted during a drain wait for the next one, and the
+// calls queued before conflation was turned on are still delivered in full.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "conflationTest");
+    EventStream<int, double>* es = EventStream<int, double>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("conflation_test");
+
+    std::vector<std::pair<int, double>> delivered;
+    es->subscribe("conflation_test", [&](int device, double value) { delivered.emplace_back(device, value); });
+
+    // Queued before conflation is turned on.
+    es->post("conflation_test", 9, 0.5);
+    es->post("conflation_test", 9, 0.75);
+    es->setConflation("conflation_test", true, [](const int& device, const double&) { return size_t(device); });
+
+    es->post("conflation_test", 1, 1.0);
+    es->post("conflation_test", 2, 2.0);
+    es->post("conflation_test", 1, 1.5);
+    es->post("conflation_test", 3, 3.0);
+    es->post("conflation_test", 2, 2.5);
+    CHECK(es->queueStats("conflation_test").coalesced == 2);
+    CHECK(es->drainPosted("conflation_test") == 5);
+    CHECK((delivered == std::vector<std::pair<int, double>>{ { 9, 0.5 }, { 9, 0.75 }, { 1, 1.5 }, { 2, 2.5 }, { 3, 3.0 } }));
+
+    // A handler posting during a drain starts a fresh set for the next drain.
+    delivered.clear();
+    es->subscribe("conflation_test", [&](int device, double value)
+    {
+        if (device == 4)
+        {
+            es->post("conflation_test", 4, value + 1.0);
+        }
+    });
+    es->post("conflation_test", 4, 4.0);
+    CHECK(es->drainPosted("conflation_test") == 1);
+    CHECK((delivered == std::vector<std::pair<int, double>>{ { 4, 4.0 } }));
+    delivered.clear();
+    CHECK(es->drainPosted("conflation_test") == 1);
+    CHECK((delivered == std::vector<std::pair<int, double>>{ { 4, 5.0 } }));
+    es->destroy("conflation_test");
+    es->requestDelete();
+
+    // Without a key function, every call shares a key: only the latest one is delivered.
+    EventStream<int>* latest = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    latest->create("conflation_latest_test");
+    std::vector<int> values;
+    latest->subscribe("conflation_latest_test", [&](int value) { values.push_back(value); });
+    latest->setConflation("conflation_latest_test", true);
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(latest->post("conflation_latest_test", i));
+    }
+    latest->drainPosted("conflation_latest_test");
+    CHECK((values == std::vector<int>{ 99 }));
+
+    // Turned off, posts are queued (and delivered) one by one again.
+    latest->setConflation("conflation_latest_test", false);
+    values.clear();
+    latest->post("conflation_latest_test", 1);
+    latest->post("conflation_latest_test", 2);
+    latest->drainPosted("conflation_latest_test");
+    CHECK((values == std::vector<int>{ 1, 2 }));
+    latest->destroy("conflation_latest_test");
+    latest->requestDelete();
+
+    return testResult("conflationTest");
+}
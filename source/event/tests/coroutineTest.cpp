@@ -0,0 +1,86 @@
+// Exercises the awaitable API of EventStream (next/when), which is only compiled when the compiler supports coroutines, so
+// this test is built as C++20 while the rest of the tree is C++17.
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "event.h"
+#include "testUtils.h"
+
+#ifndef EVENT_HAS_COROUTINES
+#error "coroutineTest.cpp must be built with coroutine support (-std=c++20)"
+#endif
+
+EventTask awaitNext(EventStream<int>* es, std::optional<int>& result, std::atomic<int>& resumed)
+{
+    result = co_await es->next("coroutine_test");
+    ++resumed;
+}
+
+EventTask awaitWhen(EventStream<int>* es, std::optional<int>& result, std::atomic<int>& resumed)
+{
+    result = co_await es->when("coroutine_test", [](int value) { return value > 100; });
+    ++resumed;
+}
+
+EventTask awaitPair(EventStream<int, std::string>* es, std::optional<std::tuple<int, std::string>>& result)
+{
+    result = co_await es->next("coroutine_pair_test");
+}
+
+EventTask awaitMissing(EventStream<int>* es, std::optional<int>& result, std::atomic<int>& resumed)
+{
+    result = co_await es->next("coroutine_missing_test");
+    ++resumed;
+}
+
+int main()
+{
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("coroutine_test");
+
+    // next() resumes on the following call only, and when() skips the calls its predicate rejects.
+    std::optional<int> nextResult, whenResult;
+    std::atomic<int> resumed(0);
+    awaitNext(es, nextResult, resumed);
+    awaitWhen(es, whenResult, resumed);
+    CHECK(resumed == 0);
+    es->call("coroutine_test", 77);
+    CHECK(resumed == 1);
+    CHECK(nextResult == 77);
+    es->call("coroutine_test", 5);
+    CHECK(resumed == 1);
+    es->call("coroutine_test", 101);
+    CHECK(resumed == 2);
+    CHECK(whenResult == 101);
+    CHECK(nextResult == 77);
+
+    // A coroutine is resumed by whichever thread delivers the Event, here a worker of the pool.
+    std::optional<int> dispatchResult;
+    awaitNext(es, dispatchResult, resumed);
+    es->dispatch("coroutine_test", 3).wait();
+    CHECK(resumed == 3);
+    CHECK(dispatchResult == 3);
+
+    // Awaiting an Event that doesn't exist doesn't suspend, and yields nothing.
+    std::optional<int> missingResult = 1;
+    awaitMissing(es, missingResult, resumed);
+    CHECK(resumed == 4);
+    CHECK(!missingResult.has_value());
+
+    // Events with several arguments yield them as a tuple.
+    EventStream<int, std::string>* pairEs = EventStream<int, std::string>::Instance(reinterpret_cast<size_t>(appDir()));
+    pairEs->create("coroutine_pair_test");
+    std::optional<std::tuple<int, std::string>> pairResult;
+    awaitPair(pairEs, pairResult);
+    pairEs->call("coroutine_pair_test", 9, std::string("nine"));
+    CHECK(pairResult.has_value() && std::get<0>(*pairResult) == 9 && std::get<1>(*pairResult) == "nine");
+
+    pairEs->destroy("coroutine_pair_test");
+    pairEs->requestDelete();
+    es->destroy("coroutine_test");
+    es->requestDelete();
+    return testResult("coroutineTest");
+}
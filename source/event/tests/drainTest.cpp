@@ -0,0 +1,57 @@
+// Checks that a handler throwing on a posted call loses that call only: the drain goes on with the following calls, and the
+// Event's queue keeps accepting and delivering posts afterwards (including from producers that block on a full queue).
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "drainTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("drain_test");
+    es->setQueuePolicy("drain_test", 4, QueuePolicy::Block);
+
+    std::vector<int> delivered;
+    es->subscribe("drain_test", [&](int value)
+    {
+        if (value < 0)
+        {
+            throw std::runtime_error("negative");
+        }
+        delivered.push_back(value);
+    });
+
+    CHECK(es->post("drain_test", 1));
+    CHECK(es->post("drain_test", -1));
+    CHECK(es->post("drain_test", 2));
+    CHECK(es->drainPosted("drain_test") == 3);
+    CHECK((delivered == std::vector<int>{ 1, 2 }));
+
+    // The drain was released, so the queue still works, and a producer blocked on the full queue gets through.
+    delivered.clear();
+    for (int i = 0; i < 4; ++i)
+    {
+        CHECK(es->post("drain_test", i == 2 ? -1 : i));
+    }
+    std::atomic<bool> posted(false);
+    std::thread producer([&] { es->post("drain_test", 4); posted = true; });
+    size_t drained = 0;
+    while (!posted || drained < 5)
+    {
+        drained += es->drainPosted("drain_test");
+        std::this_thread::yield();
+    }
+    producer.join();
+    CHECK(drained == 5);
+    CHECK((delivered == std::vector<int>{ 0, 1, 3, 4 }));
+    CHECK(es->queueStats("drain_test").pending == 0);
+
+    es->destroy("drain_test");
+    es->requestDelete();
+    return testResult("drainTest");
+}
@@ -0,0 +1,49 @@
+// Checks that an EventRef reaches its Event without a name lookup for as long as the Event exists, and that it becomes invalid
+// once the last destroy() deletes the Event, even if an Event with the same name is created again.
+
+#include "event.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "eventRefTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+
+    CHECK(!es->resolve("event_ref_missing").valid());
+
+    es->create("event_ref_test");
+    es->create("event_ref_test");
+    EventStream<int>::EventRef ref = es->resolve("event_ref_test");
+    CHECK(ref.valid());
+    CHECK(ref.name() == "event_ref_test");
+
+    int sum = 0;
+    es->subscribe(ref, [&](int value) { sum += value; });
+    es->call(ref, 2);
+    es->call("event_ref_test", 3);
+    CHECK(sum == 5);
+
+    // Copies share the state of the Event they were resolved to.
+    EventStream<int>::EventRef copy = ref;
+    es->destroy("event_ref_test");
+    CHECK(ref.valid() && copy.valid());
+    es->call(copy, 4);
+    CHECK(sum == 9);
+
+    es->destroy("event_ref_test");
+    CHECK(!ref.valid() && !copy.valid());
+    CHECK(!ref);
+    es->call(ref, 100);
+    CHECK(es->subscribe(ref, [](int) {}).empty());
+
+    // A new Event under the same name doesn't revive old references.
+    es->create("event_ref_test");
+    CHECK(!ref.valid());
+    EventStream<int>::EventRef fresh = es->resolve("event_ref_test");
+    CHECK(fresh.valid());
+    es->destroy("event_ref_test");
+    CHECK(!fresh.valid());
+
+    es->requestDelete();
+    return testResult("eventRefTest");
+}
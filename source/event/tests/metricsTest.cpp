@@ -0,0 +1,78 @@
+// Checks that handler metrics count every delivery, including the held-back calls of debounced and windowed handlers that the
+// Event's rate timer delivers, and that metrics can be read through the container while other threads create and destroy Events.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+const HandlerMetrics* find(const EventMetrics& metrics, size_t id)
+{
+    for (const auto& handler : metrics.handlers)
+    {
+        if (handler.id == id) return &handler;
+    }
+    return nullptr;
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "metricsTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("metrics_test");
+
+    std::atomic<int> debounced(0);
+    std::atomic<int> windows(0);
+    size_t plain = es->subscribe("metrics_test", [](int) {})[0];
+    size_t debounce = es->subscribeLimited("metrics_test", RateLimit::debounce(std::chrono::milliseconds(20)), [&](int) { ++debounced; });
+    size_t window = es->subscribeWindowed("metrics_test", std::chrono::milliseconds(20), [&](const int*, size_t) { ++windows; });
+    for (int i = 0; i < 5; ++i)
+    {
+        es->call("metrics_test", i);
+    }
+    while (debounced == 0 || windows == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    EventMetrics metrics = es->metrics("metrics_test");
+    CHECK(metrics.published == 5);
+    CHECK(find(metrics, plain) != nullptr && find(metrics, plain)->invocations == 5);
+    CHECK(find(metrics, debounce) != nullptr && find(metrics, debounce)->invocations == uint64_t(debounced.load()));
+    CHECK(find(metrics, window) != nullptr && find(metrics, window)->invocations == uint64_t(windows.load()));
+    CHECK(metrics.invocations == 5 + uint64_t(debounced.load()) + uint64_t(windows.load()));
+
+    // Reading every Event's metrics while Events come and go: erasing an Event's metrics source waits for the reads using it.
+    Container* pool = container();
+    std::atomic<bool> stop(false);
+    std::thread churn([&] {
+        for (int i = 0; !stop.load(); ++i)
+        {
+            std::string name = "metrics_churn_" + std::to_string(i % 4);
+            es->create(name);
+            es->subscribe(name, [](int) {});
+            es->call(name, i);
+            es->destroy(name);
+        }
+    });
+    size_t reads = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        for (const EventMetrics& eventMetrics : pool->getAllEventMetrics())
+        {
+            CHECK(!eventMetrics.name.empty());
+            ++reads;
+        }
+        EventMetrics single;
+        CHECK(pool->getEventMetrics(EventKey("metrics_test"), single) && single.published == 5);
+    }
+    stop = true;
+    churn.join();
+    CHECK(reads >= 2000);
+
+    es->destroy("metrics_test");
+    es->requestDelete();
+    return testResult("metricsTest");
+}
@@ -0,0 +1,100 @@
+// Checks dispatchOrdered: calls made with the same key are delivered one at a time and in the order they were made, while
+// calls with different keys run in parallel on the worker pool, and a handler throwing on one call doesn't hold up the calls
+// queued behind it.
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+constexpr size_t Keys = 8;
+constexpr int CallsPerKey = 500;
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "orderedTest");
+    container()->setWorkerCount(4);
+    EventStream<size_t, int>* es = EventStream<size_t, int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("ordered_test");
+
+    std::mutex lock;
+    std::vector<std::vector<int>> delivered(Keys);
+    std::atomic<int> inFlight[Keys] = {};
+    std::atomic<int> overlaps(0);
+    es->subscribe("ordered_test", [&](size_t key, int sequence)
+    {
+        if (inFlight[key].fetch_add(1) != 0)
+        {
+            ++overlaps;
+        }
+        if (sequence % 50 == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            delivered[key].push_back(sequence);
+        }
+        inFlight[key].fetch_sub(1);
+        if (sequence == 7)
+        {
+            throw std::runtime_error("ordered");
+        }
+    });
+
+    // Two producers, each making the calls of its own half of the keys, interleaved across keys.
+    std::vector<Completion> completions[2];
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < 2; ++producer)
+    {
+        producers.emplace_back([&, producer] {
+            for (int sequence = 0; sequence < CallsPerKey; ++sequence)
+            {
+                for (size_t key = producer; key < Keys; key += 2)
+                {
+                    completions[producer].push_back(es->dispatchOrdered("ordered_test", key, key, sequence));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    size_t failed = 0;
+    for (const auto& producerCompletions : completions)
+    {
+        for (const Completion& completion : producerCompletions)
+        {
+            try
+            {
+                completion.wait();
+            }
+            catch (const std::runtime_error&)
+            {
+                ++failed;
+            }
+        }
+    }
+    CHECK(failed == Keys);
+    CHECK(overlaps == 0);
+    for (size_t key = 0; key < Keys; ++key)
+    {
+        CHECK(delivered[key].size() == size_t(CallsPerKey));
+        bool inOrder = true;
+        for (size_t i = 0; i < delivered[key].size(); ++i)
+        {
+            inOrder = inOrder && delivered[key][i] == int(i);
+        }
+        CHECK(inOrder);
+    }
+
+    es->destroy("ordered_test");
+    es->requestDelete();
+    return testResult("orderedTest");
+}
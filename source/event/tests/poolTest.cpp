@@ -0,0 +1,112 @@
+// Checks the container's work-stealing worker pool: tasks queued on a busy worker's own deque get stolen by the others,
+// recursive fork-join work deeper than the number of workers completes when waiting threads help with runPendingTask, long
+// running tasks don't take workers out of rotation, and the worker count can't change once the workers are running.
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "container.h"
+#include "testUtils.h"
+
+constexpr size_t Workers = 4;
+
+// Wait for a counter to reach a value, running pool tasks meanwhile.
+void helpUntil(Container* pool, const std::atomic<int>& counter, int value)
+{
+    while (counter.load() < value)
+    {
+        if (!pool->runPendingTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Sum of [begin, end) computed by splitting the range in halves down to single numbers, with one half handed to the pool each time.
+long long forkJoinSum(Container* pool, long long begin, long long end)
+{
+    if (end - begin == 1)
+    {
+        return begin;
+    }
+    long long middle = begin + (end - begin) / 2;
+    std::atomic<int> done(0);
+    long long right = 0;
+    pool->submitTask([&] { right = forkJoinSum(pool, middle, end); done = 1; });
+    long long left = forkJoinSum(pool, begin, middle);
+    helpUntil(pool, done, 1);
+    return left + right;
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "poolTest");
+    Container* pool = container();
+    pool->setWorkerCount(Workers);
+    CHECK(pool->getWorkerCount() == Workers);
+
+    // A worker pushes tasks onto its own deque and then blocks until they've all run: only the other workers can run them.
+    std::atomic<int> stolen(0);
+    std::mutex threadsLock;
+    std::set<std::thread::id> threads;
+    std::atomic<int> ownerDone(0);
+    pool->submitTask([&] {
+        std::thread::id owner = std::this_thread::get_id();
+        for (int i = 0; i < 64; ++i)
+        {
+            pool->submitTask([&, owner] {
+                std::lock_guard<std::mutex> lock(threadsLock);
+                threads.insert(std::this_thread::get_id());
+                CHECK(std::this_thread::get_id() != owner);
+                ++stolen;
+            });
+        }
+        while (stolen.load() < 64)
+        {
+            std::this_thread::yield();
+        }
+        ownerDone = 1;
+    });
+    while (ownerDone.load() == 0)
+    {
+        std::this_thread::yield();
+    }
+    CHECK(stolen == 64);
+    CHECK(!threads.empty());
+
+    // The setting is fixed once the workers are running.
+    pool->setWorkerCount(Workers + 1);
+    CHECK(pool->getWorkerCount() == Workers);
+
+    // Recursive work whose depth exceeds the worker count.
+    std::atomic<int> sumDone(0);
+    long long sum = 0;
+    pool->submitTask([&] { sum = forkJoinSum(pool, 1, 1001); sumDone = 1; });
+    helpUntil(pool, sumDone, 1);
+    CHECK(sum == 1000LL * 1001 / 2);
+
+    // Long running tasks get threads of their own, so they can wait on pool tasks even when there are more of them than workers.
+    std::atomic<int> release(0);
+    std::atomic<int> longRunningDone(0);
+    for (size_t i = 0; i < Workers + 2; ++i)
+    {
+        pool->submitLongRunningTask([&] {
+            while (release.load() == 0)
+            {
+                std::this_thread::yield();
+            }
+            ++longRunningDone;
+        });
+    }
+    pool->submitTask([&] { release = 1; });
+    while (longRunningDone.load() < int(Workers + 2))
+    {
+        std::this_thread::yield();
+    }
+
+    return testResult("poolTest");
+}
@@ -0,0 +1,123 @@
+// Checks that a handler of one Event posting to another Event whose queue is full and uses QueuePolicy::Block never hangs the
+// thread draining both of them, whether the queues are drained explicitly or by the container's dispatcher thread: the full
+// queue is drained inline, or, if its drain is already under way on the same thread, the call is rejected.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "event.h"
+#include "testUtils.h"
+
+constexpr size_t Capacity = 4;
+constexpr int Calls = 8;
+constexpr int PostsPerCall = 10;
+
+// Wait until both Events have nothing left to deliver, draining them from this thread unless the dispatcher thread does it.
+void settle(EventStream<int>* es, const std::string& first, const std::string& second, bool dispatcher)
+{
+    while (es->queueStats(first).pending != 0 || es->queueStats(second).pending != 0)
+    {
+        if (dispatcher)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        else
+        {
+            es->drainPosted();
+        }
+    }
+}
+
+// The handler of first posts PostsPerCall calls to second, which has room for Capacity of them.
+void testChain(EventStream<int>* es, bool dispatcher)
+{
+    std::string first = dispatcher ? "cross_chain_a_dispatcher" : "cross_chain_a";
+    std::string second = dispatcher ? "cross_chain_b_dispatcher" : "cross_chain_b";
+    es->create(first);
+    es->create(second);
+    es->setQueuePolicy(second, Capacity, QueuePolicy::Block);
+
+    std::atomic<int> delivered(0);
+    es->subscribe(first, [&](int value)
+    {
+        for (int i = 0; i < PostsPerCall; ++i)
+        {
+            CHECK(es->post(second, value * PostsPerCall + i));
+        }
+    });
+    es->subscribe(second, [&](int) { ++delivered; });
+
+    for (int i = 0; i < Calls; ++i)
+    {
+        CHECK(es->post(first, i));
+    }
+    settle(es, first, second, dispatcher);
+
+    QueueStats stats = es->queueStats(second);
+    CHECK(delivered == Calls * PostsPerCall);
+    CHECK(stats.overflows > 0);
+    CHECK(stats.dropped == 0);
+
+    es->destroy(first);
+    es->destroy(second);
+}
+
+// Both handlers post back and forth until a call's value runs out, so a post may find the other queue full while that queue's
+// drain is further up the same thread's stack; such posts are rejected, and every other one is delivered.
+void testCycle(EventStream<int>* es, bool dispatcher)
+{
+    std::string first = dispatcher ? "cross_cycle_a_dispatcher" : "cross_cycle_a";
+    std::string second = dispatcher ? "cross_cycle_b_dispatcher" : "cross_cycle_b";
+    es->create(first);
+    es->create(second);
+    es->setQueuePolicy(first, Capacity, QueuePolicy::Block);
+    es->setQueuePolicy(second, Capacity, QueuePolicy::Block);
+
+    std::atomic<int> posted(0);
+    std::atomic<int> delivered(0);
+    auto bounce = [&](const std::string& target)
+    {
+        return [&, target](int hops)
+        {
+            ++delivered;
+            for (int i = 0; hops > 0 && i < 3; ++i)
+            {
+                ++posted;
+                es->post(target, hops - 1);
+            }
+        };
+    };
+    es->subscribe(first, bounce(second));
+    es->subscribe(second, bounce(first));
+
+    for (size_t i = 0; i < Capacity; ++i)
+    {
+        ++posted;
+        CHECK(es->post(first, 3));
+    }
+    settle(es, first, second, dispatcher);
+
+    size_t dropped = es->queueStats(first).dropped + es->queueStats(second).dropped;
+    CHECK(delivered + dropped == size_t(posted.load()));
+
+    es->destroy(first);
+    es->destroy(second);
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "postCrossTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+
+    testChain(es, false);
+    testCycle(es, false);
+
+    container()->setPostedDispatcher(true);
+    testChain(es, true);
+    testCycle(es, true);
+    container()->setPostedDispatcher(false);
+
+    es->requestDelete();
+    return testResult("postCrossTest");
+}
@@ -0,0 +1,69 @@
+// Checks that a handler posting to its own Event while that Event's queue is being drained (and is full) never hangs the
+// drain, whatever the Event's QueuePolicy, and that every call ends up either delivered, dropped or coalesced.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include "event.h"
+#include "testUtils.h"
+
+constexpr size_t Capacity = 4;
+// A hung drain can't be interrupted, so give up on the whole test after this long.
+constexpr std::chrono::seconds Timeout = std::chrono::seconds(20);
+
+void testSelfPost(EventStream<int>* es, const std::string& eventName, QueuePolicy policy)
+{
+    es->create(eventName);
+    es->setQueuePolicy(eventName, Capacity, policy);
+
+    size_t delivered = 0;
+    size_t reposts = 0;
+    es->subscribe(eventName, [&](int value)
+    {
+        ++delivered;
+        if (value < 100)
+        {
+            ++reposts;
+            es->post(eventName, value + 100);
+        }
+    });
+
+    for (int i = 0; i < int(Capacity); ++i)
+    {
+        CHECK(es->post(eventName, i));
+    }
+    for (size_t drains = 0; drains < 10 && es->drainPosted(eventName) > 0; ++drains) {}
+
+    QueueStats stats = es->queueStats(eventName);
+    std::cout << eventName << ": delivered " << delivered << ", dropped " << stats.dropped << ", coalesced " << stats.coalesced
+        << ", overflows " << stats.overflows << std::endl;
+    CHECK(reposts == Capacity);
+    CHECK(stats.overflows > 0);
+    CHECK(stats.pending == 0);
+    CHECK(delivered + stats.dropped + stats.coalesced == Capacity + reposts);
+    if (policy != QueuePolicy::Coalesce)
+    {
+        CHECK(stats.dropped > 0);
+    }
+
+    es->destroy(eventName);
+}
+
+int main()
+{
+    std::thread([] {
+        std::this_thread::sleep_for(Timeout);
+        std::cout << "postSelfTest: FAILED (timed out, a drain is stuck)" << std::endl;
+        std::_Exit(1);
+    }).detach();
+
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    testSelfPost(es, "self_post_block", QueuePolicy::Block);
+    testSelfPost(es, "self_post_drop_oldest", QueuePolicy::DropOldest);
+    testSelfPost(es, "self_post_drop_newest", QueuePolicy::DropNewest);
+    testSelfPost(es, "self_post_coalesce", QueuePolicy::Coalesce);
+    es->requestDelete();
+    return testResult("postSelfTest");
+}
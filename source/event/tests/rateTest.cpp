@@ -0,0 +1,95 @@
+// Checks the rate gates of rate-limited subscriptions: sampling lets every Nth call through, throttling the first call of each
+// interval, debouncing only the latest call once the calls stop, and windowing hands each interval's calls over as one batch;
+// calls held back for a handler that is unsubscribed (or an Event that is destroyed) meanwhile are dropped.
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+using namespace std::chrono_literals;
+
+// Wait (for at most a few seconds) until a condition holds.
+template <typename F> bool eventually(F condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "rateTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("rate_test");
+
+    std::mutex lock;
+    std::vector<int> sampled;
+    std::vector<int> throttled;
+    std::vector<int> debounced;
+    std::vector<std::vector<int>> windows;
+    es->subscribeLimited("rate_test", RateLimit::sample(3), [&](int value) { sampled.push_back(value); });
+    es->subscribeLimited("rate_test", RateLimit::throttle(500ms), [&](int value) { throttled.push_back(value); });
+    es->subscribeLimited("rate_test", RateLimit::debounce(50ms), [&](int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        debounced.push_back(value);
+    });
+    es->subscribeWindowed("rate_test", 100ms, [&](const int* values, size_t count)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        windows.emplace_back(values, values + count);
+    });
+
+    for (int i = 1; i <= 9; ++i)
+    {
+        es->call("rate_test", i);
+    }
+    CHECK((sampled == std::vector<int>{ 3, 6, 9 }));
+    CHECK((throttled == std::vector<int>{ 1 }));
+
+    CHECK(eventually([&] { std::lock_guard<std::mutex> guard(lock); return !debounced.empty() && !windows.empty(); }));
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        CHECK((debounced == std::vector<int>{ 9 }));
+        CHECK((windows.front() == std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    }
+
+    // Nothing else is delivered once the calls have stopped, and the throttle opens up again after its interval.
+    std::this_thread::sleep_for(600ms);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        CHECK(debounced.size() == 1);
+        CHECK(windows.size() == 1);
+    }
+    es->call("rate_test", 10);
+    CHECK((throttled == std::vector<int>{ 1, 10 }));
+    CHECK(eventually([&] { std::lock_guard<std::mutex> guard(lock); return debounced.size() == 2 && windows.size() == 2; }));
+
+    // A debounced call held back for a handler that is then unsubscribed is dropped.
+    std::atomic<int> dropped(0);
+    size_t held = es->subscribeLimited("rate_test", RateLimit::debounce(100ms), [&](int) { ++dropped; });
+    es->call("rate_test", 11);
+    es->unsubscribe("rate_test", held);
+    std::this_thread::sleep_for(300ms);
+    CHECK(dropped == 0);
+
+    // Destroying the Event while calls are held back stops its rate timer without delivering them.
+    es->subscribeLimited("rate_test", RateLimit::debounce(1s), [&](int) { ++dropped; });
+    es->call("rate_test", 12);
+    es->destroy("rate_test");
+    CHECK(dropped == 0);
+
+    es->requestDelete();
+    return testResult("rateTest");
+}
@@ -0,0 +1,75 @@
+// Checks that the Events of EventStream<R(Args...)> reduce and collect their handlers' results in subscription order, and that
+// calls running while other threads subscribe and unsubscribe always see a whole handler list, up to the Event's destruction.
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "reduceEventStream.h"
+#include "testUtils.h"
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "reduceTest");
+    EventStream<int(int)>* es = EventStream<int(int)>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("reduce_test");
+
+    es->subscribe("reduce_test", [](int x) { return x; }, [](int x) { return x * 10; }, [](int x) { return x * 100; });
+    CHECK(es->call("reduce_test", 0, std::plus<int>(), 2) == 222);
+    CHECK(es->callAsync("reduce_test", 1, std::plus<int>(), 3) == 334);
+    CHECK((es->collect("reduce_test", 1) == std::vector<int>{ 1, 10, 100 }));
+    CHECK((es->collectAsync("reduce_test", 2) == std::vector<int>{ 2, 20, 200 }));
+    // Concatenating digits is associative but not commutative, so the reduction tree has to keep the handlers in order.
+    auto append = [](int left, int right) {
+        int shift = 10;
+        while (shift <= right) shift *= 10;
+        return left * shift + right;
+    };
+    CHECK(es->callAsync("reduce_test", 0, append, 1) == 110100);
+
+    // Churn handlers that always return 0 while other threads call the Event: the three original handlers must always be seen.
+    std::atomic<bool> stop(false);
+    std::thread churn([&] {
+        while (!stop.load())
+        {
+            std::vector<size_t> ids = es->subscribe("reduce_test", [](int) { return 0; });
+            es->unsubscribe("reduce_test", ids);
+        }
+    });
+    std::vector<std::thread> callers;
+    std::atomic<int> wrongSums(0);
+    for (int i = 0; i < 4; ++i)
+    {
+        callers.emplace_back([&, i] {
+            for (int round = 0; round < 2000; ++round)
+            {
+                int sum = i % 2 == 0 ? es->call("reduce_test", 0, std::plus<int>(), 1) : es->callAsync("reduce_test", 0, std::plus<int>(), 1);
+                if (sum != 111) ++wrongSums;
+            }
+        });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+    stop = true;
+    churn.join();
+    CHECK(wrongSums == 0);
+
+    // Destroying while a call is in flight waits for it.
+    std::atomic<bool> entered(false);
+    es->subscribe("reduce_test", [&](int) { entered = true; std::this_thread::sleep_for(std::chrono::milliseconds(200)); return 0; });
+    std::atomic<int> slowSum(-1);
+    std::thread slowCaller([&] { slowSum = es->call("reduce_test", 0, std::plus<int>(), 1); });
+    while (!entered.load())
+    {
+        std::this_thread::yield();
+    }
+    es->destroy("reduce_test");
+    CHECK(slowSum == 111);
+    slowCaller.join();
+
+    es->requestDelete();
+    return testResult("reduceTest");
+}
@@ -0,0 +1,68 @@
+// Checks the generational slot map behind handler ids: freed slots are reused by later subscriptions under a new generation,
+// so stale ids (and ids of another Event's handlers) never remove the wrong handler, and removal keeps the remaining handlers
+// in subscription order.
+
+#include <string>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+// The low bits of an id select its slot (see Event::SlotBits).
+constexpr size_t SlotMask = (size_t(1) << 24) - 1;
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "slotMapTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("slot_map_test");
+    es->create("slot_map_other");
+
+    std::string order;
+    std::vector<size_t> ids = es->subscribe("slot_map_test", [&](int) { order += 'a'; }, [&](int) { order += 'b'; }, [&](int) { order += 'c'; });
+    CHECK(ids.size() == 3 && ids[0] != ids[1] && ids[1] != ids[2] && ids[0] != ids[2]);
+
+    es->unsubscribe("slot_map_test", ids[1]);
+    size_t reused = es->subscribe("slot_map_test", [&](int) { order += 'd'; })[0];
+    CHECK((reused & SlotMask) == (ids[1] & SlotMask));
+    CHECK(reused != ids[1]);
+
+    es->call("slot_map_test", 0);
+    CHECK(order == "acd");
+
+    // The stale id of the removed handler must not remove the handler that now sits in its slot.
+    es->unsubscribe("slot_map_test", ids[1]);
+    order.clear();
+    es->call("slot_map_test", 0);
+    CHECK(order == "acd");
+
+    // Nor may an id handed out by another Event, even one whose slot index matches.
+    size_t foreign = es->subscribe("slot_map_other", [](int) {})[0];
+    CHECK((foreign & SlotMask) == (ids[0] & SlotMask));
+    es->unsubscribe("slot_map_test", foreign);
+    order.clear();
+    es->call("slot_map_test", 0);
+    CHECK(order == "acd");
+
+    // Removing several handlers at once compacts the rest in order, and every freed slot gets reused.
+    std::vector<size_t> more = es->subscribe("slot_map_test", [&](int) { order += 'e'; }, [&](int) { order += 'f'; });
+    es->unsubscribe("slot_map_test", std::vector<size_t>{ ids[0], more[0], reused });
+    order.clear();
+    es->call("slot_map_test", 0);
+    CHECK(order == "cf");
+
+    std::vector<size_t> refill = es->subscribe("slot_map_test", [&](int) { order += 'g'; }, [&](int) { order += 'h'; }, [&](int) { order += 'i'; });
+    for (size_t id : refill)
+    {
+        size_t slot = id & SlotMask;
+        CHECK(slot == (ids[0] & SlotMask) || slot == (more[0] & SlotMask) || slot == (reused & SlotMask));
+    }
+    order.clear();
+    es->call("slot_map_test", 0);
+    CHECK(order == "cfghi");
+
+    es->destroy("slot_map_test");
+    es->destroy("slot_map_other");
+    es->requestDelete();
+    return testResult("slotMapTest");
+}
@@ -0,0 +1,90 @@
+// Checks the handler snapshots of an Event under concurrent subscription and calls: every call sees a whole handler list, a
+// handler may subscribe and unsubscribe from inside a call, and every retired snapshot (along with whatever its handlers
+// captured) is freed by the time the Event is destroyed.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+// Counts the live copies of the handlers that capture it, so leaked snapshots show up.
+struct Tracker
+{
+    static inline std::atomic<int> live = 0;
+    Tracker() { ++live; }
+    Tracker(const Tracker&) { ++live; }
+    ~Tracker() { --live; }
+};
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "snapshotTest");
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("snapshot_test");
+
+    // Two fixed handlers that every call must reach, whatever the churn around them.
+    std::atomic<long> fixedRuns(0);
+    es->subscribe("snapshot_test", [&](int) { ++fixedRuns; }, [&](int) { ++fixedRuns; });
+
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w)
+    {
+        writers.emplace_back([&] {
+            while (!stop.load())
+            {
+                Tracker tracker;
+                std::vector<size_t> ids = es->subscribe("snapshot_test", [tracker](int) {});
+                es->unsubscribe("snapshot_test", ids);
+            }
+        });
+    }
+
+    const int Callers = 3;
+    const int CallsPerCaller = 20000;
+    std::vector<std::thread> callers;
+    for (int c = 0; c < Callers; ++c)
+    {
+        callers.emplace_back([&] {
+            for (int i = 0; i < CallsPerCaller; ++i)
+            {
+                es->call("snapshot_test", i);
+            }
+        });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+    stop = true;
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    CHECK(fixedRuns == 2L * Callers * CallsPerCaller);
+
+    // A handler changing the subscriptions of the Event it's called by only affects later calls.
+    std::vector<size_t> added;
+    int nestedRuns = 0;
+    std::vector<size_t> reentrant = es->subscribe("snapshot_test", [&](int value)
+    {
+        if (value == -1)
+        {
+            added = es->subscribe("snapshot_test", [&](int) { ++nestedRuns; });
+        }
+    });
+    es->call("snapshot_test", -1);
+    CHECK(nestedRuns == 0);
+    es->call("snapshot_test", 0);
+    CHECK(nestedRuns == 1);
+    es->unsubscribe("snapshot_test", added);
+    es->unsubscribe("snapshot_test", reentrant);
+
+    es->destroy("snapshot_test");
+    CHECK(Tracker::live == 0);
+    es->requestDelete();
+    return testResult("snapshotTest");
+}
@@ -0,0 +1,71 @@
+// Checks that a sticky Event replays the arguments of its latest call to handlers subscribed afterwards, both for arguments
+// kept in place (trivially copyable) and for arguments kept on the heap, including while other threads keep calling it.
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+template <typename T> void testSticky(const std::string& eventName, const T& first, const T& latest)
+{
+    EventStream<T>* es = EventStream<T>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create(eventName);
+
+    // Nothing is retained until the Event is made sticky.
+    es->call(eventName, first);
+    es->setSticky(eventName, true);
+    int replays = 0;
+    es->subscribe(eventName, [&](T) { ++replays; });
+    CHECK(replays == 0);
+
+    es->call(eventName, first);
+    es->call(eventName, latest);
+    T seen{};
+    es->subscribe(eventName, [&](T value) { seen = value; });
+    CHECK(seen == latest);
+
+    // While calls keep changing the retained arguments, every replay sees the arguments of one whole call.
+    std::atomic<bool> stop(false);
+    std::thread caller([&] {
+        for (bool flip = false; !stop.load(); flip = !flip)
+        {
+            es->call(eventName, flip ? first : latest);
+        }
+    });
+    std::atomic<int> torn(0);
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::vector<size_t> ids = es->subscribe(eventName, [&](T value) { if (!(value == first) && !(value == latest)) ++torn; });
+        es->unsubscribe(eventName, ids);
+    }
+    stop = true;
+    caller.join();
+    CHECK(torn == 0);
+
+    // Turning stickiness off forgets the arguments.
+    es->setSticky(eventName, false);
+    es->setSticky(eventName, true);
+    replays = 0;
+    std::vector<size_t> ids = es->subscribe(eventName, [&](T) { ++replays; });
+    CHECK(replays == 0);
+
+    es->destroy(eventName);
+    es->requestDelete();
+}
+
+struct Wide
+{
+    long long a, b, c, d;
+    bool operator==(const Wide& other) const { return a == other.a && b == other.b && c == other.c && d == other.d; }
+};
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "stickyTest");
+    testSticky<Wide>("sticky_inline", Wide{ 1, 1, 1, 1 }, Wide{ 2, 2, 2, 2 });
+    testSticky<std::string>("sticky_heap", std::string(64, 'a'), std::string(64, 'b'));
+    return testResult("stickyTest");
+}
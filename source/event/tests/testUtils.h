@@ -0,0 +1,62 @@
+#ifndef TESTUTILS_H
+#define TESTUTILS_H
+
+// Minimal helpers shared by the Event tests. Every test is a standalone executable that lives next to container.so (in the
+// build's bin folder), loads it the way plugins do, and exits with a non-zero status if any check failed.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <climits>
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include "container.h"
+
+inline int g_failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { std::cout << "CHECK FAILED: " << #condition << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; ++g_failures; } } while (false)
+
+// The test executable's directory, which EventStream::Instance needs in order to find container.so.
+inline const char* appDir()
+{
+    static std::string exeDir;
+    if (exeDir.empty())
+    {
+        char cPath[PATH_MAX] = {};
+        readlink("/proc/self/exe", cPath, PATH_MAX - 1);
+        exeDir = cPath;
+        exeDir.erase(exeDir.find_last_of('/') + 1);
+    }
+    return exeDir.c_str();
+}
+
+// The container the EventStreams loaded, for the tests that use it directly (e.g. to submit tasks to the worker pool).
+inline Container* container()
+{
+    void* containerHandle = dlopen((std::string(appDir()) + "container.so").c_str(), RTLD_NOW);
+    typedef Container* (*fnCreateContainer)();
+    fnCreateContainer createContainer = (fnCreateContainer)dlsym(containerHandle, "Create");
+    return createContainer();
+}
+
+// A hung test can't be interrupted from the inside, so fail the whole test if it's still running after the given time.
+inline void failAfter(std::chrono::seconds timeout, const char* testName)
+{
+    std::thread([timeout, testName] {
+        std::this_thread::sleep_for(timeout);
+        std::cout << testName << ": FAILED (timed out)" << std::endl;
+        std::_Exit(1);
+    }).detach();
+}
+
+inline int testResult(const char* testName)
+{
+    std::cout << testName << (g_failures == 0 ? ": passed" : ": FAILED") << std::endl;
+    return g_failures == 0 ? 0 : 1;
+}
+
+#endif // TESTUTILS_H
@@ -0,0 +1,79 @@
+// Checks topic matching: '*' matches exactly one segment and '#' any number of them (none included), wherever they sit in a
+// pattern, matches come back sorted and without duplicates, erasing prunes the trie, and wildcard subscriptions reach the
+// matching Events whether they were created before or after subscribing.
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "event.h"
+#include "testUtils.h"
+
+bool matches(std::string_view pattern, std::string_view topic)
+{
+    TopicTrie trie;
+    trie.insert(pattern, 1);
+    return !trie.match(topic).empty();
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(20), "topicTest");
+
+    CHECK(TopicTrie::isPattern("a.*") && TopicTrie::isPattern("#") && !TopicTrie::isPattern("a.b") && !TopicTrie::isPattern("a.b*"));
+
+    CHECK(matches("a.b", "a.b") && !matches("a.b", "a") && !matches("a.b", "a.b.c"));
+    CHECK(matches("a.*", "a.b") && !matches("a.*", "a") && !matches("a.*", "a.b.c"));
+    CHECK(matches("*.*", "a.b") && !matches("*.*", "a") && !matches("*.*", "a.b.c"));
+    CHECK(matches("a.#", "a") && matches("a.#", "a.b") && matches("a.#", "a.b.c") && !matches("a.#", "b.a"));
+    CHECK(matches("#", "a") && matches("#", "a.b.c"));
+    CHECK(matches("a.#.z", "a.z") && matches("a.#.z", "a.b.z") && matches("a.#.z", "a.b.c.z") && !matches("a.#.z", "a.b"));
+    CHECK(matches("a.*.#", "a.b") && matches("a.*.#", "a.b.c") && !matches("a.*.#", "a"));
+    CHECK(matches("#.z", "z") && matches("#.z", "a.b.z") && !matches("#.z", "z.a"));
+    // A segment containing a wildcard character is a literal.
+    CHECK(matches("a.b*", "a.b*") && !matches("a.b*", "a.bc"));
+
+    // Several patterns matching the same topic, some of them more than once ("#.#"), each report their id once, in order.
+    TopicTrie trie;
+    trie.insert("#.#", 5);
+    trie.insert("a.*", 3);
+    trie.insert("a.b", 1);
+    trie.insert("#", 4);
+    trie.insert("a.b", 2);
+    trie.insert("c.#", 6);
+    CHECK((trie.match("a.b") == std::vector<size_t>{ 1, 2, 3, 4, 5 }));
+    CHECK((trie.match("c") == std::vector<size_t>{ 4, 5, 6 }));
+
+    CHECK(trie.erase("a.b", 1));
+    CHECK(!trie.erase("a.b", 1));
+    CHECK(!trie.erase("a.c", 2));
+    CHECK(trie.erase("#.#", 5));
+    CHECK((trie.match("a.b") == std::vector<size_t>{ 2, 3, 4 }));
+
+    // Wildcard subscriptions through an EventStream.
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+    es->create("topic.keyboard.pressed");
+    std::vector<std::string> seen;
+    size_t deep = es->subscribePattern("topic.#", [&](std::string_view name, int) { seen.emplace_back(name); });
+    size_t shallow = es->subscribePattern("topic.*", [&](int) { seen.emplace_back("*"); });
+    es->create("topic.mouse");
+    es->create("other.mouse");
+
+    es->call("topic.keyboard.pressed", 0);
+    es->call("topic.mouse", 0);
+    es->call("other.mouse", 0);
+    CHECK((seen == std::vector<std::string>{ "topic.keyboard.pressed", "topic.mouse", "*" }));
+
+    es->unsubscribePattern(deep);
+    seen.clear();
+    es->call("topic.keyboard.pressed", 0);
+    es->call("topic.mouse", 0);
+    CHECK((seen == std::vector<std::string>{ "*" }));
+    es->unsubscribePattern(shallow);
+
+    es->destroy("topic.keyboard.pressed");
+    es->destroy("topic.mouse");
+    es->destroy("other.mouse");
+    es->requestDelete();
+    return testResult("topicTest");
+}
@@ -0,0 +1,109 @@
+// Checks the watchdog's overrun policies for dispatches with a deadline: Report lets the dispatch run to completion, Cancel
+// cancels it (the running handler can notice, the queued ones are skipped), and Detach also stops the dispatch's Completion
+// from waiting on the overrunning handler, which keeps running in the background until it returns.
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "event.h"
+#include "testUtils.h"
+
+using namespace std::chrono_literals;
+
+// Subscribe a handler that takes longer than the deadline, and a quick one queued behind it (the pool has a single worker).
+void subscribe(EventStream<int>* es, const std::string& eventName, std::function<void(int)> slow, std::atomic<int>& quickRuns)
+{
+    es->create(eventName);
+    es->subscribe(eventName, [slow](int value) { slow(value); });
+    es->subscribe(eventName, [&quickRuns](int) { ++quickRuns; });
+}
+
+// Wait for a dispatch once its deadline has passed: waiting straight away would run the queued handlers on this thread
+// before the watchdog gets to them.
+void waitPastDeadline(const Completion& completion)
+{
+    std::this_thread::sleep_for(150ms);
+    completion.wait();
+}
+
+// Spin until the dispatch running the handler is cancelled, or give up after a while.
+bool waitForCancel()
+{
+    auto giveUp = std::chrono::steady_clock::now() + 5s;
+    while (!Completion::current().isCancelled())
+    {
+        if (std::chrono::steady_clock::now() > giveUp)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+int main()
+{
+    failAfter(std::chrono::seconds(30), "watchdogTest");
+    container()->setWorkerCount(1);
+    EventStream<int>* es = EventStream<int>::Instance(reinterpret_cast<size_t>(appDir()));
+
+    std::atomic<int> quickRuns(0);
+    subscribe(es, "watchdog_report", [](int) { std::this_thread::sleep_for(200ms); }, quickRuns);
+    Completion reported = es->dispatchWithin("watchdog_report", 50ms, OverrunPolicy::Report, 0);
+    waitPastDeadline(reported);
+    CHECK(!reported.isCancelled());
+    CHECK(quickRuns == 1);
+    es->destroy("watchdog_report");
+
+    std::atomic<bool> sawCancel(false);
+    quickRuns = 0;
+    subscribe(es, "watchdog_cancel", [&](int slow) { sawCancel = slow != 0 && waitForCancel(); }, quickRuns);
+    Completion cancelled = es->dispatchWithin("watchdog_cancel", 50ms, OverrunPolicy::Cancel, 1);
+    waitPastDeadline(cancelled);
+    CHECK(cancelled.isCancelled());
+    CHECK(sawCancel);
+    CHECK(quickRuns == 0);
+
+    // A deadline set on the Event applies to every dispatch.
+    sawCancel = false;
+    es->setDeadline("watchdog_cancel", 50ms, OverrunPolicy::Cancel);
+    Completion dispatched = es->dispatch("watchdog_cancel", 1);
+    waitPastDeadline(dispatched);
+    CHECK(dispatched.isCancelled());
+    CHECK(sawCancel);
+    CHECK(quickRuns == 0);
+
+    // Without a deadline, nothing gets cancelled.
+    es->setDeadline("watchdog_cancel", 0ns);
+    Completion unbounded = es->dispatch("watchdog_cancel", 0);
+    waitPastDeadline(unbounded);
+    CHECK(!unbounded.isCancelled());
+    CHECK(quickRuns == 1);
+    es->destroy("watchdog_cancel");
+
+    // The detached handler ignores cancellation, so it's still running once its dispatch's Completion is ready.
+    std::atomic<bool> release(false);
+    std::atomic<bool> finished(false);
+    quickRuns = 0;
+    subscribe(es, "watchdog_detach", [&](int)
+    {
+        while (!release.load())
+        {
+            std::this_thread::yield();
+        }
+        finished = true;
+    }, quickRuns);
+    Completion detached = es->dispatchWithin("watchdog_detach", 50ms, OverrunPolicy::Detach, 0);
+    waitPastDeadline(detached);
+    CHECK(detached.isCancelled());
+    CHECK(!finished);
+    release = true;
+    es->destroy("watchdog_detach");
+    CHECK(finished);
+    CHECK(quickRuns == 0);
+
+    es->requestDelete();
+    return testResult("watchdogTest");
+}
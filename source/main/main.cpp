@@ -18,6 +18,7 @@ int main(int argc, char* argv[])
     getPaths();
     addPathsToSys(sys);
     parseConfigFile(g_StartupFile);
+    configureContainer();
     loadPlugins(sys);
     start(sys);
     stop(sys);
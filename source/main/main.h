@@ -19,6 +19,7 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <map>
@@ -46,6 +47,11 @@ namespace
     std::vector<std::string> g_PlgNames;
     std::vector<std::string> g_PlgPaths;
     std::vector<Plugin*> g_PlgPtrs;
+    size_t g_WorkerThreads = 0;
+    // worker_threads is capped at this many workers per hardware thread, so that a typo can't spawn thousands of threads.
+    const size_t MaxWorkerThreadsPerCore = 4;
+    bool g_EventDispatcher = false;
+    std::vector<std::pair<std::string, std::string>> g_EventAffinities;
 
     #ifdef _WIN32
     char delimiter = '\\';
@@ -138,6 +144,19 @@ void addPathToContainer()
     }
 }
 
+// Pass the worker pool size, the posted Event dispatcher setting and the Event affinities read from the configuration file on
+// to the container, which owns the pool of worker threads, the posted Event queues and the executors shared by all plugins.
+void configureContainer()
+{
+    addPathToContainer();
+    m_container->setWorkerCount(g_WorkerThreads);
+    m_container->setPostedDispatcher(g_EventDispatcher);
+    for (const auto& affinity : g_EventAffinities)
+    {
+        m_container->setEventAffinity(affinity.first, affinity.second);
+    }
+}
+
 // Parse the configuration (or .py) file to determine what plugins should be
 // registered in the update loop of the application during startup.
 void parseConfigFile(std::string filePath)
@@ -176,6 +195,77 @@ void parseConfigFile(std::string filePath)
                 }
             }
 
+            else if (type == "worker_threads")
+            {
+                std::string count = line.substr(delimiterPos + 1);
+                size_t maxWorkers = MaxWorkerThreadsPerCore * std::max(std::thread::hardware_concurrency(), 1u);
+                size_t workers = 0;
+                bool valid = !count.empty() && std::all_of(count.begin(), count.end(), ::isdigit);
+                if (valid)
+                {
+                    try
+                    {
+                        workers = std::stoul(count);
+                    }
+                    catch (const std::out_of_range&)
+                    {
+                        valid = false;
+                    }
+                }
+
+                if (!valid)
+                {
+                    std::cout << "Unable to read worker_threads; default to one worker per hardware thread" << std::endl;
+                }
+                else if (workers > maxWorkers)
+                {
+                    std::cout << "worker_threads = " << count << " is more than " << maxWorkers << "; unable to start that many workers, start " << maxWorkers << " instead" << std::endl;
+                    g_WorkerThreads = maxWorkers;
+                }
+                else
+                {
+                    g_WorkerThreads = workers;
+                }
+            }
+
+            else if (type == "event_dispatcher")
+            {
+                std::string enabled = line.substr(delimiterPos + 1);
+                if (enabled == "0" || enabled == "1")
+                {
+                    g_EventDispatcher = enabled == "1";
+                }
+                else
+                {
+                    std::cout << "Unable to read event_dispatcher; default to draining posted Events in the runner tick" << std::endl;
+                }
+            }
+
+            else if (type == "event_affinity")
+            {
+                std::string entry;
+                for (size_t i = delimiterPos + 1; i <= line.length(); ++i)
+                {
+                    if (line[i] == ',' || i == line.length())
+                    {
+                        size_t equalPos = entry.find("=");
+                        if (equalPos != std::string::npos && equalPos > 0 && equalPos + 1 < entry.length())
+                        {
+                            g_EventAffinities.emplace_back(entry.substr(0, equalPos), entry.substr(equalPos + 1));
+                        }
+                        else if (!entry.empty())
+                        {
+                            std::cout << "Unable to read event_affinity entry " << entry << "; expected <event name>=<affinity>" << std::endl;
+                        }
+                        entry.clear();
+                    }
+                    else
+                    {
+                        entry.push_back(line[i]);
+                    }
+                }
+            }
+
             else if (type == "config_dirs")
             {
                 std::string _configPath;
@@ -226,6 +316,7 @@ void initialize(pybind11::module_ sys)
     // Load all plugins listed in config file.
     for (unsigned int i = 0; i < g_PlgNames.size(); ++i)
     {
+        m_container->setCurrentPlugin(g_PlgNames[i]);
         std::string pyPluginDir = g_PlgsDir + g_PlgNames[i] + delimiter + "scripts";
         std::string pyPluginPath = pyPluginDir + delimiter + g_PlgNames[i] + ".py";
         // If there exists a valid .py plugin, we assume that all initialization/updating/releasing behavior is handled
@@ -250,6 +341,7 @@ void initialize(pybind11::module_ sys)
             g_PlgPtrs.push_back(g_PlgsMan->Load(g_PlgNames[i].c_str()));
         }
     }
+    m_container->setCurrentPlugin("");
 }
 
 // Global release (unload) function for all plug-ins.
@@ -283,6 +375,7 @@ void start(pybind11::module_ sys)
 {
     for (unsigned int i = 0; i < g_PlgNames.size(); ++i)
     {
+        m_container->setCurrentPlugin(g_PlgNames[i]);
         std::string pyPluginDir = g_PlgsDir + g_PlgNames[i] + delimiter + "scripts";
         std::string pyPluginPath = pyPluginDir + delimiter + g_PlgNames[i] + ".py";
         // If we're loading python plugins, then assume all start functions will be called via python.
@@ -302,6 +395,7 @@ void start(pybind11::module_ sys)
             g_PlgPtrs[i]->start();
         }
     }
+    m_container->setCurrentPlugin("");
 }
 
 // Global stop function for all loaded plug-ins.
@@ -309,6 +403,7 @@ void stop(pybind11::module_ sys)
 {
     for (unsigned int i = 0; i < g_PlgNames.size(); ++i)
     {
+        m_container->setCurrentPlugin(g_PlgNames[i]);
         std::string pyPluginDir = g_PlgsDir + g_PlgNames[i] + delimiter + "scripts";
         std::string pyPluginPath = pyPluginDir + delimiter + g_PlgNames[i] + ".py";
         // If we're loading python plugins, then assume all stop functions will be called via python.
@@ -328,6 +423,7 @@ void stop(pybind11::module_ sys)
             g_PlgPtrs[i]->stop();
         }
     }
+    m_container->setCurrentPlugin("");
 }
 
 // Initialize at startup whatever plugins the configuration file specified.